@@ -6,6 +6,8 @@
 [BaseContainerProps(configRoot: true), BaseContainerCustomStringTitleField("Crew Config")]
 class AFM_CrewConfig
 {
+	protected static const ResourceName GROUP_PREFAB = "{000CD338713F2B5A}Prefabs/AI/Groups/Group_Base.et";
+	
 	[Attribute("", UIWidgets.ResourceAssignArray, desc: "Driver character prefab (if empty, uses vehicle default)", params: "et")]
 	protected ResourceName m_sDriverPrefab;
 	
@@ -31,7 +33,7 @@ class AFM_CrewConfig
 	{
 		if (!cm)
 		{
-			Print("AFM_CrewConfig: Invalid compartment manager!", LogLevel.ERROR);
+			AFM_DiDLog.Write(EAFMDiDLogCategory.CREW, LogLevel.ERROR, "AFM_CrewConfig: Invalid compartment manager!");
 			return null;
 		}
 		
@@ -53,16 +55,21 @@ class AFM_CrewConfig
 		AIGroup aiGroup = CreateAIGroup();
 		if (!aiGroup)
 		{
-			Print("AFM_CrewConfig: Failed to create AI group!", LogLevel.ERROR);
+			AFM_DiDLog.Write(EAFMDiDLogCategory.CREW, LogLevel.ERROR, "AFM_CrewConfig: Failed to create AI group!");
 			return null;
 		}
 		
+		// Register crew as attackers before anyone is spawned into the group
+		AFM_DiDZoneSystem zoneSystem = AFM_DiDZoneSystem.GetInstance();
+		if (zoneSystem)
+			zoneSystem.GetAttackerRegistry().TrackGroup(aiGroup);
+		
 		// Spawn driver
 		if (m_bSpawnDriver && driverSlot)
 		{
 			IEntity driver = SpawnCharacterInSlot(driverSlot, m_sDriverPrefab, aiGroup);
-			if (driver)
-				PrintFormat("AFM_CrewConfig: Spawned driver in %1", driverSlot.GetCompartmentName(), LogLevel.DEBUG);
+			if (driver && AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.CREW, LogLevel.DEBUG))
+				AFM_DiDLog.Write(EAFMDiDLogCategory.CREW, LogLevel.DEBUG, string.Format("AFM_CrewConfig: Spawned driver in %1", driverSlot.GetCompartmentName()));
 		}
 		
 		// Spawn gunner
@@ -71,7 +78,8 @@ class AFM_CrewConfig
 			IEntity gunner = SpawnCharacterInSlot(gunnerSlot, m_sGunnerPrefab, aiGroup);
 			if (gunner)
 			{
-				PrintFormat("AFM_CrewConfig: Spawned gunner in %1", gunnerSlot.GetCompartmentName(), LogLevel.DEBUG);
+				if (AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.CREW, LogLevel.DEBUG))
+					AFM_DiDLog.Write(EAFMDiDLogCategory.CREW, LogLevel.DEBUG, string.Format("AFM_CrewConfig: Spawned gunner in %1", gunnerSlot.GetCompartmentName()));
 				
 				// Prevent dismount if configured
 				if (m_bNoTurretDismount)
@@ -87,12 +95,27 @@ class AFM_CrewConfig
 		if (assignedWaypoint)
 		{
 			aiGroup.AddWaypoint(assignedWaypoint);
-			PrintFormat("AFM_CrewConfig: Assigned waypoint to AI group", LogLevel.DEBUG);
+			if (AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.CREW, LogLevel.DEBUG))
+				AFM_DiDLog.Write(EAFMDiDLogCategory.CREW, LogLevel.DEBUG, "AFM_CrewConfig: Assigned waypoint to AI group");
 		}
 		
 		return aiGroup;
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Append prefabs spawned by this crew config, used for preloading
+	//! Vehicle default occupants are only known per vehicle instance and are not included
+	//------------------------------------------------------------------------------------------------
+	void CollectPrefabs(notnull array<ResourceName> outPrefabs)
+	{
+		outPrefabs.Insert(GROUP_PREFAB);
+		
+		if (m_bSpawnDriver && !m_sDriverPrefab.IsEmpty())
+			outPrefabs.Insert(m_sDriverPrefab);
+		if (m_bSpawnGunner && !m_sGunnerPrefab.IsEmpty())
+			outPrefabs.Insert(m_sGunnerPrefab);
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	//! Find first available slot of specified type
 	//------------------------------------------------------------------------------------------------
@@ -142,10 +165,10 @@ class AFM_CrewConfig
 	//------------------------------------------------------------------------------------------------
 	protected AIGroup CreateAIGroup()
 	{
-		Resource groupResource = Resource.Load("{000CD338713F2B5A}Prefabs/AI/Groups/Group_Base.et");
-		if (!groupResource || !groupResource.IsValid())
+		Resource groupResource = AFM_DiDPrefabCache.Load(GROUP_PREFAB);
+		if (!groupResource)
 		{
-			Print("AFM_CrewConfig: Failed to load AI group resource!", LogLevel.ERROR);
+			AFM_DiDLog.Write(EAFMDiDLogCategory.CREW, LogLevel.ERROR, "AFM_CrewConfig: Failed to load AI group resource!");
 			return null;
 		}
 		
@@ -155,7 +178,7 @@ class AFM_CrewConfig
 		IEntity groupEntity = GetGame().SpawnEntityPrefab(groupResource, GetGame().GetWorld(), spawnParams);
 		if (!groupEntity)
 		{
-			Print("AFM_CrewConfig: Failed to spawn AI group entity!", LogLevel.ERROR);
+			AFM_DiDLog.Write(EAFMDiDLogCategory.CREW, LogLevel.ERROR, "AFM_CrewConfig: Failed to spawn AI group entity!");
 			return null;
 		}
 		
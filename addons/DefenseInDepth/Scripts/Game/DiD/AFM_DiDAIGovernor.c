@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------------------------
+//! Global attacker AI budget driven by server frame time
+//! Budget shrinks multiplicatively while the server runs below the target FPS and grows
+//! additively while there is headroom and the current budget is actually used
+//------------------------------------------------------------------------------------------------
+class AFM_DiDAIGovernor
+{
+	// Weight of a new frame time sample in the moving average
+	protected static const float FRAME_TIME_SMOOTHING = 0.05;
+	
+	// Budget is cut to this fraction of the live count when below target FPS
+	protected static const float DECREASE_FACTOR = 0.9;
+	
+	// FPS above target * this is considered headroom
+	protected static const float HEADROOM_FACTOR = 1.2;
+	
+	// Longer gaps are pauses or loading hitches, not frame time
+	protected static const int MAX_FRAME_TIME_MS = 1000;
+	
+	protected float m_fTargetFPS;
+	protected int m_iMinBudget;
+	protected int m_iMaxBudget;
+	protected int m_iIncreaseStep;
+	
+	protected int m_iBudget;
+	protected float m_fAvgFrameTime;
+	protected int m_iLastTick = -1;
+	
+	//------------------------------------------------------------------------------------------------
+	void AFM_DiDAIGovernor(float targetFPS, int minBudget, int maxBudget, int increaseStep)
+	{
+		m_fTargetFPS = Math.Max(1, targetFPS);
+		m_iMinBudget = Math.Max(0, minBudget);
+		m_iMaxBudget = Math.Max(m_iMinBudget, maxBudget);
+		m_iIncreaseStep = Math.Max(1, increaseStep);
+		m_iBudget = m_iMaxBudget;
+		m_fAvgFrameTime = 1 / m_fTargetFPS;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Feed the system tick in ms, called from every fixed frame update
+	//! The world time slice follows the fixed timestep, real frame time is the tick difference
+	//! between updates. Fixed steps run back to back in one frame share a tick and are skipped
+	//------------------------------------------------------------------------------------------------
+	void SampleTick(int tick)
+	{
+		int delta = tick - m_iLastTick;
+		if (m_iLastTick >= 0 && delta <= 0)
+			return;
+		
+		bool hasLastTick = m_iLastTick >= 0;
+		m_iLastTick = tick;
+		if (!hasLastTick || delta > MAX_FRAME_TIME_MS)
+			return;
+		
+		float frameTime = delta * 0.001;
+		m_fAvgFrameTime += (frameTime - m_fAvgFrameTime) * FRAME_TIME_SMOOTHING;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Recompute budget, called once per second from the zone system housekeeping
+	//! @param liveCount Attacker agents currently alive
+	//------------------------------------------------------------------------------------------------
+	void Update(int liveCount)
+	{
+		float fps = GetServerFPS();
+	
+		if (fps < m_fTargetFPS)
+		{
+			// Shed load relative to what is actually alive, an unused budget is no relief
+			int reduced = Math.Floor(Math.Min(m_iBudget, liveCount) * DECREASE_FACTOR);
+			m_iBudget = Math.Max(m_iMinBudget, reduced);
+		}
+		else if (fps > m_fTargetFPS * HEADROOM_FACTOR && liveCount >= m_iBudget - m_iIncreaseStep)
+		{
+			m_iBudget = Math.Min(m_iMaxBudget, m_iBudget + m_iIncreaseStep);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int GetBudget()
+	{
+		return m_iBudget;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int GetMaxBudget()
+	{
+		return m_iMaxBudget;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	float GetServerFPS()
+	{
+		return 1 / m_fAvgFrameTime;
+	}
+}
\ No newline at end of file
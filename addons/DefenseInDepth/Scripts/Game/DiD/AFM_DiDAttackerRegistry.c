@@ -0,0 +1,157 @@
+//------------------------------------------------------------------------------------------------
+//! Single attacker tracked by the registry
+//------------------------------------------------------------------------------------------------
+class AFM_DiDAttackerEntry
+{
+	AIAgent m_Agent;
+	SCR_ChimeraCharacter m_Character;
+	
+	// Result of the last exact presence check, reused while the agent stays within clearance
+	protected AFM_DiDZoneGeometry m_CheckedGeometry;
+	protected vector m_vCheckedPosition;
+	protected float m_fClearance;
+	protected bool m_bInside;
+	
+	//------------------------------------------------------------------------------------------------
+	//! Resolve controlled character, agents may be registered before their entity is assigned
+	//------------------------------------------------------------------------------------------------
+	SCR_ChimeraCharacter GetCharacter()
+	{
+		if (!m_Character && m_Agent)
+			m_Character = SCR_ChimeraCharacter.Cast(m_Agent.GetControlledEntity());
+		
+		return m_Character;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool IsAlive()
+	{
+		SCR_ChimeraCharacter character = GetCharacter();
+		if (!character)
+			return false;
+		
+		SCR_DamageManagerComponent damageManager = character.GetDamageManager();
+		return damageManager && !damageManager.IsDestroyed();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Is attacker inside given zone geometry, polygon test only runs again when the agent
+	//! moved farther than its clearance since the last check
+	//------------------------------------------------------------------------------------------------
+	bool IsInside(AFM_DiDZoneGeometry geometry)
+	{
+		vector pos = m_Character.GetOrigin();
+		
+		if (m_CheckedGeometry == geometry)
+		{
+			float dx = pos[0] - m_vCheckedPosition[0];
+			float dz = pos[2] - m_vCheckedPosition[2];
+			if (dx * dx + dz * dz < m_fClearance * m_fClearance)
+				return m_bInside;
+		}
+		
+		m_bInside = geometry.IsPointInsideWithClearance(pos[0], pos[2], m_fClearance);
+		m_CheckedGeometry = geometry;
+		m_vCheckedPosition = pos;
+		return m_bInside;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//! Registry of attacker agents spawned by DiD spawners
+//! Fed by AFM_DiDSpawnerComponent.SpawnAI and AFM_CrewConfig.SpawnCrew, agents are dropped when
+//! they leave their group (death, deletion) so presence checks never scan the whole AIWorld
+//------------------------------------------------------------------------------------------------
+class AFM_DiDAttackerRegistry
+{
+	protected ref array<ref AFM_DiDAttackerEntry> m_aEntries = {};
+	
+	//------------------------------------------------------------------------------------------------
+	//! Register current group members and hook group so later members are registered as well
+	//------------------------------------------------------------------------------------------------
+	void TrackGroup(AIGroup group)
+	{
+		SCR_AIGroup scrGroup = SCR_AIGroup.Cast(group);
+		if (scrGroup)
+			scrGroup.SetAttackerRegistry(this);
+		
+		array<AIAgent> agents = {};
+		group.GetAgents(agents);
+		foreach (AIAgent agent : agents)
+		{
+			Register(agent);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void Register(AIAgent agent)
+	{
+		if (!agent || Find(agent) != -1)
+			return;
+		
+		AFM_DiDAttackerEntry entry = new AFM_DiDAttackerEntry();
+		entry.m_Agent = agent;
+		m_aEntries.Insert(entry);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void Unregister(AIAgent agent)
+	{
+		int index = Find(agent);
+		if (index != -1)
+			m_aEntries.Remove(index);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Remove entry by index, last entry is moved into its place
+	//------------------------------------------------------------------------------------------------
+	void RemoveAt(int index)
+	{
+		m_aEntries.Remove(index);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void RemoveEntry(AFM_DiDAttackerEntry entry)
+	{
+		int index = m_aEntries.Find(entry);
+		if (index != -1)
+			m_aEntries.Remove(index);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Copy entries into outEntries, reusing its allocation
+	//------------------------------------------------------------------------------------------------
+	void CopyEntries(notnull array<ref AFM_DiDAttackerEntry> outEntries)
+	{
+		outEntries.Copy(m_aEntries);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int Find(AIAgent agent)
+	{
+		for (int i = m_aEntries.Count() - 1; i >= 0; i--)
+		{
+			if (m_aEntries[i].m_Agent == agent)
+				return i;
+		}
+		return -1;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	AFM_DiDAttackerEntry Get(int index)
+	{
+		return m_aEntries[index];
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int Count()
+	{
+		return m_aEntries.Count();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void Clear()
+	{
+		m_aEntries.Clear();
+	}
+}
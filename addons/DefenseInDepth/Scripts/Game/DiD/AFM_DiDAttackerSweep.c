@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------------------------
+//! Incremental attacker census for one zone
+//! Walks a snapshot of the attacker registry across frames under an agent budget and
+//! publishes counts once the whole snapshot was checked
+//------------------------------------------------------------------------------------------------
+class AFM_DiDAttackerSweep
+{
+	protected ref array<ref AFM_DiDAttackerEntry> m_aSnapshot = {};
+	protected AFM_DiDAttackerRegistry m_Registry;
+	protected AFM_DiDZoneComponent m_Zone;
+	protected int m_iCursor;
+	protected int m_iInside;
+	protected int m_iTotal;
+	protected bool m_bRunning;
+	
+	// Last completed sweep
+	protected AFM_DiDZoneComponent m_ResultZone;
+	protected int m_iResultInside;
+	protected int m_iResultTotal;
+	
+	//------------------------------------------------------------------------------------------------
+	void Begin(AFM_DiDAttackerRegistry registry, AFM_DiDZoneComponent zone)
+	{
+		m_Registry = registry;
+		m_Zone = zone;
+		m_iCursor = 0;
+		m_iInside = 0;
+		m_iTotal = 0;
+		m_bRunning = true;
+		
+		// Snapshot keeps the cursor valid while agents leave the registry mid sweep
+		registry.CopyEntries(m_aSnapshot);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Check up to budget attackers, returns true when the sweep completed during this step
+	//------------------------------------------------------------------------------------------------
+	bool Step(int budget)
+	{
+		if (!m_bRunning)
+			return false;
+		
+		if (!m_Zone)
+		{
+			Cancel();
+			return false;
+		}
+		
+		AFM_DiDZoneGeometry geometry = m_Zone.GetGeometry();
+		int end = Math.Min(m_iCursor + budget, m_aSnapshot.Count());
+		while (m_iCursor < end)
+		{
+			AFM_DiDAttackerEntry entry = m_aSnapshot[m_iCursor];
+			m_iCursor++;
+			
+			if (!entry.IsAlive())
+			{
+				// Drop deleted agents and dead characters, keep agents still waiting for their entity
+				if (!entry.m_Agent || entry.GetCharacter())
+					m_Registry.RemoveEntry(entry);
+				continue;
+			}
+			
+			if (entry.IsInside(geometry))
+				m_iInside++;
+			m_iTotal++;
+		}
+		
+		if (m_iCursor < m_aSnapshot.Count())
+			return false;
+		
+		m_ResultZone = m_Zone;
+		m_iResultInside = m_iInside;
+		m_iResultTotal = m_iTotal;
+		Cancel();
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void Cancel()
+	{
+		m_bRunning = false;
+		m_aSnapshot.Clear();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void Reset()
+	{
+		Cancel();
+		m_ResultZone = null;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool IsRunning()
+	{
+		return m_bRunning;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Fill census with the last published result, returns false when there is none for this zone yet
+	//------------------------------------------------------------------------------------------------
+	bool GetResult(AFM_DiDZoneComponent zone, AFM_DiDZoneCensus census)
+	{
+		if (!m_ResultZone || m_ResultZone != zone)
+			return false;
+		
+		census.m_iAttackersInside = m_iResultInside;
+		census.m_iAttackersTotal = m_iResultTotal;
+		return true;
+	}
+}
@@ -0,0 +1,149 @@
+//------------------------------------------------------------------------------------------------
+//! Corpse or wreck left behind by a DiD spawner
+//------------------------------------------------------------------------------------------------
+class AFM_DiDCollectorEntry
+{
+	IEntity m_Entity;
+	WorldTimestamp m_fDeathTime;
+	int m_iZoneIndex;
+	bool m_bWreck;
+}
+
+//------------------------------------------------------------------------------------------------
+//! Removes attacker corpses and destroyed vehicles spawned by DiD spawners
+//! Entries are removed once old enough and far enough from all defenders, zones keeping more
+//! than the cap lose their oldest entries first. Removal goes through the despawn queue
+//------------------------------------------------------------------------------------------------
+class AFM_DiDCollector
+{
+	protected ref array<ref AFM_DiDCollectorEntry> m_aEntries = {};
+	
+	// Spawned vehicles checked for destruction on every update
+	protected ref array<IEntity> m_aVehicles = {};
+	protected ref array<int> m_aVehicleZones = {};
+	
+	//------------------------------------------------------------------------------------------------
+	//! Track dead attacker character
+	//------------------------------------------------------------------------------------------------
+	void AddCorpse(IEntity corpse, int zoneIndex)
+	{
+		if (!corpse)
+			return;
+	
+		AddEntry(corpse, zoneIndex, false);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Track spawned vehicle, collected once destroyed
+	//------------------------------------------------------------------------------------------------
+	void AddVehicle(IEntity vehicle, int zoneIndex)
+	{
+		if (!vehicle)
+			return;
+	
+		m_aVehicles.Insert(vehicle);
+		m_aVehicleZones.Insert(zoneIndex);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Hand expired entries over to the despawn queue
+	//! @param observers Alive defenders, entries closer than minDistance to any of them are kept
+	//! @param maxCorpseAge Seconds after death a corpse may be removed
+	//! @param maxWreckAge Seconds after destruction a wreck may be removed
+	//! @param minDistance Min distance in meters from defenders for removal by age
+	//! @param maxPerZone Max entries per zone, oldest are removed regardless of distance (0 = no cap)
+	//------------------------------------------------------------------------------------------------
+	void Update(array<IEntity> observers, float maxCorpseAge, float maxWreckAge, float minDistance, int maxPerZone, notnull AFM_DiDDespawnQueue despawnQueue)
+	{
+		ChimeraWorld world = GetGame().GetWorld();
+		WorldTimestamp now = world.GetServerTimestamp();
+	
+		CheckVehicles();
+	
+		float minDistanceSq = minDistance * minDistance;
+		map<int, int> zoneCounts = new map<int, int>();
+	
+		// Entries are ordered by death time, iterate newest first so caps drop the oldest
+		for (int i = m_aEntries.Count() - 1; i >= 0; i--)
+		{
+			AFM_DiDCollectorEntry entry = m_aEntries[i];
+			if (!entry.m_Entity)
+			{
+				m_aEntries.RemoveOrdered(i);
+				continue;
+			}
+	
+			int zoneCount = zoneCounts.Get(entry.m_iZoneIndex) + 1;
+			zoneCounts.Set(entry.m_iZoneIndex, zoneCount);
+	
+			bool remove = maxPerZone > 0 && zoneCount > maxPerZone;
+			if (!remove)
+			{
+				float maxAge = maxCorpseAge;
+				if (entry.m_bWreck)
+					maxAge = maxWreckAge;
+	
+				remove = now.DiffSeconds(entry.m_fDeathTime) >= maxAge && !IsNearObserver(entry.m_Entity, observers, minDistanceSq);
+			}
+	
+			if (!remove)
+				continue;
+	
+			despawnQueue.Enqueue(entry.m_Entity);
+			m_aEntries.RemoveOrdered(i);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int Count()
+	{
+		return m_aEntries.Count();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void AddEntry(IEntity entity, int zoneIndex, bool wreck)
+	{
+		ChimeraWorld world = GetGame().GetWorld();
+	
+		AFM_DiDCollectorEntry entry = new AFM_DiDCollectorEntry();
+		entry.m_Entity = entity;
+		entry.m_fDeathTime = world.GetServerTimestamp();
+		entry.m_iZoneIndex = zoneIndex;
+		entry.m_bWreck = wreck;
+		m_aEntries.Insert(entry);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Move destroyed vehicles to the entries, deleted vehicles are dropped
+	//------------------------------------------------------------------------------------------------
+	protected void CheckVehicles()
+	{
+		for (int i = m_aVehicles.Count() - 1; i >= 0; i--)
+		{
+			IEntity vehicle = m_aVehicles[i];
+			if (vehicle)
+			{
+				SCR_DamageManagerComponent damageManager = SCR_DamageManagerComponent.GetDamageManager(vehicle);
+				if (!damageManager || !damageManager.IsDestroyed())
+					continue;
+	
+				AddEntry(vehicle, m_aVehicleZones[i], true);
+			}
+	
+			m_aVehicles.Remove(i);
+			m_aVehicleZones.Remove(i);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected bool IsNearObserver(IEntity entity, array<IEntity> observers, float distanceSq)
+	{
+		vector pos = entity.GetOrigin();
+		foreach (IEntity observer : observers)
+		{
+			if (observer && vector.DistanceSq(pos, observer.GetOrigin()) < distanceSq)
+				return true;
+		}
+		return false;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,198 @@
+//------------------------------------------------------------------------------------------------
+//! Keeps alive defenders up to date from game mode spawn, kill and disconnect events
+//! so the defender count is a constant time read instead of a walk over all players
+//------------------------------------------------------------------------------------------------
+class AFM_DiDDefenderTracker
+{
+	protected SCR_BaseGameMode m_GameMode;
+	protected SCR_Faction m_DefenderFaction;
+	
+	// Parallel arrays, index i holds player id and controlled entity of one alive defender
+	protected ref array<int> m_aPlayerIds = {};
+	protected ref array<IEntity> m_aEntities = {};
+	
+	protected ref ScriptInvoker m_OnDefenderCountChanged;
+	
+	//------------------------------------------------------------------------------------------------
+	void Init(SCR_BaseGameMode gameMode, SCR_Faction defenderFaction)
+	{
+		if (m_GameMode)
+			Deinit();
+		
+		m_GameMode = gameMode;
+		m_DefenderFaction = defenderFaction;
+		
+		if (m_GameMode)
+		{
+			m_GameMode.GetOnPlayerSpawned().Insert(OnPlayerSpawned);
+			m_GameMode.GetOnPlayerKilled().Insert(OnPlayerKilled);
+			m_GameMode.GetOnPlayerDisconnected().Insert(OnPlayerDisconnected);
+		}
+		
+		Resync();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void Deinit()
+	{
+		if (m_GameMode)
+		{
+			m_GameMode.GetOnPlayerSpawned().Remove(OnPlayerSpawned);
+			m_GameMode.GetOnPlayerKilled().Remove(OnPlayerKilled);
+			m_GameMode.GetOnPlayerDisconnected().Remove(OnPlayerDisconnected);
+		}
+		
+		m_GameMode = null;
+		m_aPlayerIds.Clear();
+		m_aEntities.Clear();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Rebuild the list from all defender players, used on start and zone changes
+	//! to pick up players that took control of an entity without a spawn event
+	//------------------------------------------------------------------------------------------------
+	void Resync()
+	{
+		int previousCount = GetCount();
+		m_aPlayerIds.Clear();
+		m_aEntities.Clear();
+		
+		if (m_DefenderFaction)
+		{
+			array<int> playerIds = {};
+			m_DefenderFaction.GetPlayersInFaction(playerIds);
+			
+			PlayerManager playerManager = GetGame().GetPlayerManager();
+			foreach (int id : playerIds)
+			{
+				PlayerController pc = playerManager.GetPlayerController(id);
+				if (!pc)
+					continue;
+				
+				IEntity entity = pc.GetControlledEntity();
+				if (IsAliveDefender(entity))
+				{
+					m_aPlayerIds.Insert(id);
+					m_aEntities.Insert(entity);
+				}
+			}
+		}
+		
+		if (previousCount != GetCount())
+			NotifyCountChanged();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int GetCount()
+	{
+		return m_aEntities.Count();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	array<IEntity> GetAliveDefenders()
+	{
+		return m_aEntities;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Append positions of alive defenders, entities deleted without a kill event are dropped
+	//------------------------------------------------------------------------------------------------
+	void CollectPositions(notnull array<vector> outPositions)
+	{
+		bool changed = false;
+		for (int i = m_aEntities.Count() - 1; i >= 0; i--)
+		{
+			IEntity entity = m_aEntities[i];
+			if (!entity)
+			{
+				RemoveAt(i);
+				changed = true;
+				continue;
+			}
+			
+			outPositions.Insert(entity.GetOrigin());
+		}
+		
+		if (changed)
+			NotifyCountChanged();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Invoked with the new defender count
+	//------------------------------------------------------------------------------------------------
+	ScriptInvoker GetOnDefenderCountChanged()
+	{
+		if (!m_OnDefenderCountChanged)
+			m_OnDefenderCountChanged = new ScriptInvoker();
+		
+		return m_OnDefenderCountChanged;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	// Game mode events
+	//------------------------------------------------------------------------------------------------
+	
+	protected void OnPlayerSpawned(int playerId, IEntity controlledEntity)
+	{
+		int index = m_aPlayerIds.Find(playerId);
+		if (index != -1)
+			RemoveAt(index);
+		
+		if (IsAliveDefender(controlledEntity))
+		{
+			m_aPlayerIds.Insert(playerId);
+			m_aEntities.Insert(controlledEntity);
+		}
+		
+		NotifyCountChanged();
+	}
+	
+	protected void OnPlayerKilled(notnull SCR_InstigatorContextData instigatorContextData)
+	{
+		RemovePlayer(instigatorContextData.GetVictimPlayerID());
+	}
+	
+	protected void OnPlayerDisconnected(int playerId, KickCauseCode cause, int timeout)
+	{
+		RemovePlayer(playerId);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void RemovePlayer(int playerId)
+	{
+		int index = m_aPlayerIds.Find(playerId);
+		if (index == -1)
+			return;
+		
+		RemoveAt(index);
+		NotifyCountChanged();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void RemoveAt(int index)
+	{
+		m_aPlayerIds.Remove(index);
+		m_aEntities.Remove(index);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected bool IsAliveDefender(IEntity entity)
+	{
+		SCR_ChimeraCharacter character = SCR_ChimeraCharacter.Cast(entity);
+		if (!character || !m_DefenderFaction)
+			return false;
+		
+		if (character.GetFactionKey() != m_DefenderFaction.GetFactionKey())
+			return false;
+		
+		SCR_DamageManagerComponent damageManager = character.GetDamageManager();
+		return damageManager && !damageManager.IsDestroyed();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void NotifyCountChanged()
+	{
+		if (m_OnDefenderCountChanged)
+			m_OnDefenderCountChanged.Invoke(GetCount());
+	}
+}
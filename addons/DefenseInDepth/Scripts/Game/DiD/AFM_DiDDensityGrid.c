@@ -0,0 +1,223 @@
+//------------------------------------------------------------------------------------------------
+//! Defender density over the zone bounding box
+//! Every cell holds the number of defenders within the target radius of its center, built by
+//! splatting each defender into the cells around it. The densest cell in mortar range is then
+//! refined on a sub-cell lattice with exact counts
+//------------------------------------------------------------------------------------------------
+class AFM_DiDDensityGrid
+{
+	protected const int MAX_GRID_CELLS = 262144;
+	
+	// Sub-cell offsets per axis tested around the best cell, as fraction of cell size
+	protected static const float REFINE_STEP = 0.25;
+	protected static const int REFINE_STEPS = 2;
+	
+	protected AFM_DiDZoneGeometry m_Geometry;
+	protected float m_fCellSize;
+	protected float m_fRadius;
+	protected float m_fMinX;
+	protected float m_fMinZ;
+	protected int m_iWidth;
+	protected int m_iHeight;
+	
+	// Cells with the center inside the zone, cell index = row * width + col
+	protected ref array<bool> m_aInside = {};
+	protected ref array<int> m_aCounts = {};
+	
+	// Defender positions of the last build, used for refinement
+	protected ref array<vector> m_aPositions;
+	
+	//------------------------------------------------------------------------------------------------
+	//! Lay grid over zone bounds, returns false for invalid geometry or too many cells
+	//! @param cellSize Cell edge length in meters
+	//! @param radius Radius in meters around a target counted as hit
+	//------------------------------------------------------------------------------------------------
+	bool Init(AFM_DiDZoneGeometry geometry, float cellSize, float radius)
+	{
+		m_aInside.Clear();
+		m_aCounts.Clear();
+		m_iWidth = 0;
+		m_iHeight = 0;
+		
+		if (!geometry || !geometry.IsValid() || cellSize <= 0)
+			return false;
+		
+		vector minBounds, maxBounds;
+		geometry.GetBounds(minBounds, maxBounds);
+		
+		int width = Math.Max(1, Math.Ceil((maxBounds[0] - minBounds[0]) / cellSize));
+		int height = Math.Max(1, Math.Ceil((maxBounds[2] - minBounds[2]) / cellSize));
+		if (width * height > MAX_GRID_CELLS)
+			return false;
+		
+		m_Geometry = geometry;
+		m_fCellSize = cellSize;
+		m_fRadius = radius;
+		m_fMinX = minBounds[0];
+		m_fMinZ = minBounds[2];
+		m_iWidth = width;
+		m_iHeight = height;
+		
+		int cellCount = width * height;
+		m_aInside.Resize(cellCount);
+		m_aCounts.Resize(cellCount);
+		
+		for (int row = 0; row < height; row++)
+		{
+			for (int col = 0; col < width; col++)
+			{
+				m_aInside[row * width + col] = geometry.IsPointInside(GetCellCenter(col, row));
+			}
+		}
+		
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool IsValid()
+	{
+		return m_iWidth > 0;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Recount all cells from defender positions
+	//------------------------------------------------------------------------------------------------
+	void Build(array<vector> positions)
+	{
+		m_aPositions = positions;
+		
+		int cellCount = m_aCounts.Count();
+		for (int i = 0; i < cellCount; i++)
+		{
+			m_aCounts[i] = 0;
+		}
+		
+		if (!positions)
+			return;
+		
+		float radiusSq = m_fRadius * m_fRadius;
+		foreach (vector pos : positions)
+		{
+			// Range of cells whose center may lie within radius
+			int minCol = Math.Max(0, Math.Floor((pos[0] - m_fRadius - m_fMinX) / m_fCellSize));
+			int maxCol = Math.Min(m_iWidth - 1, Math.Floor((pos[0] + m_fRadius - m_fMinX) / m_fCellSize));
+			int minRow = Math.Max(0, Math.Floor((pos[2] - m_fRadius - m_fMinZ) / m_fCellSize));
+			int maxRow = Math.Min(m_iHeight - 1, Math.Floor((pos[2] + m_fRadius - m_fMinZ) / m_fCellSize));
+			
+			for (int row = minRow; row <= maxRow; row++)
+			{
+				float dz = m_fMinZ + (row + 0.5) * m_fCellSize - pos[2];
+				for (int col = minCol; col <= maxCol; col++)
+				{
+					float dx = m_fMinX + (col + 0.5) * m_fCellSize - pos[0];
+					if (dx * dx + dz * dz <= radiusSq)
+						m_aCounts[row * m_iWidth + col] = m_aCounts[row * m_iWidth + col] + 1;
+				}
+			}
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Position inside the zone with most defenders within radius, range is measured in 2D from origin
+	//! Returns vector.Zero when no cell is inside the zone and in range
+	//! @param[out] targetCount Defenders within radius of returned position
+	//------------------------------------------------------------------------------------------------
+	vector FindBest(vector origin, float minRange, float maxRange, out int targetCount)
+	{
+		targetCount = -1;
+		
+		float minRangeSq = minRange * minRange;
+		float maxRangeSq = maxRange * maxRange;
+		
+		int bestCell = -1;
+		for (int row = 0; row < m_iHeight; row++)
+		{
+			float dz = m_fMinZ + (row + 0.5) * m_fCellSize - origin[2];
+			for (int col = 0; col < m_iWidth; col++)
+			{
+				int cell = row * m_iWidth + col;
+				if (m_aCounts[cell] <= targetCount || !m_aInside[cell])
+					continue;
+				
+				float dx = m_fMinX + (col + 0.5) * m_fCellSize - origin[0];
+				float distSq = dx * dx + dz * dz;
+				if (distSq < minRangeSq || distSq > maxRangeSq)
+					continue;
+				
+				bestCell = cell;
+				targetCount = m_aCounts[cell];
+			}
+		}
+		
+		if (bestCell < 0)
+			return vector.Zero;
+		
+		vector best = GetCellCenter(bestCell % m_iWidth, bestCell / m_iWidth);
+		if (targetCount == 0)
+			return best;
+		
+		return Refine(best, origin, minRangeSq, maxRangeSq, targetCount);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int GetCellCount()
+	{
+		return m_aCounts.Count();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Test sub-cell lattice around center with exact counts, keeps center unless a point beats it
+	//------------------------------------------------------------------------------------------------
+	protected vector Refine(vector center, vector origin, float minRangeSq, float maxRangeSq, inout int targetCount)
+	{
+		vector best = center;
+		float step = m_fCellSize * REFINE_STEP;
+		
+		for (int i = -REFINE_STEPS; i <= REFINE_STEPS; i++)
+		{
+			for (int j = -REFINE_STEPS; j <= REFINE_STEPS; j++)
+			{
+				if (i == 0 && j == 0)
+					continue;
+				
+				vector candidate = Vector(center[0] + i * step, 0, center[2] + j * step);
+				
+				float dx = candidate[0] - origin[0];
+				float dz = candidate[2] - origin[2];
+				float distSq = dx * dx + dz * dz;
+				if (distSq < minRangeSq || distSq > maxRangeSq)
+					continue;
+				
+				int count = CountInRadius(candidate);
+				if (count <= targetCount || !m_Geometry.IsPointInside(candidate))
+					continue;
+				
+				best = candidate;
+				targetCount = count;
+			}
+		}
+		
+		return best;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected int CountInRadius(vector center)
+	{
+		int count;
+		float radiusSq = m_fRadius * m_fRadius;
+		foreach (vector pos : m_aPositions)
+		{
+			float dx = pos[0] - center[0];
+			float dz = pos[2] - center[2];
+			if (dx * dx + dz * dz <= radiusSq)
+				count++;
+		}
+		return count;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected vector GetCellCenter(int col, int row)
+	{
+		return Vector(m_fMinX + (col + 0.5) * m_fCellSize, 0, m_fMinZ + (row + 0.5) * m_fCellSize);
+	}
+}
\ No newline at end of file
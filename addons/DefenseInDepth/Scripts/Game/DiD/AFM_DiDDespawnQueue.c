@@ -0,0 +1,178 @@
+//------------------------------------------------------------------------------------------------
+//! Entity waiting for deletion
+//------------------------------------------------------------------------------------------------
+class AFM_DiDDespawnEntry
+{
+	IEntity m_Entity;
+	float m_fDistanceSq;
+	bool m_bScored;
+	WorldTimestamp m_fFirstDeferTime;
+	bool m_bDeferred;
+}
+
+//------------------------------------------------------------------------------------------------
+//! Tears down entities of finished zones over several frames under a budget
+//! Entities far from defenders are deleted first, entities in front of a nearby defender
+//! are deferred until they leave view or the max defer time passes
+//------------------------------------------------------------------------------------------------
+class AFM_DiDDespawnQueue
+{
+	protected ref array<ref AFM_DiDDespawnEntry> m_aEntries = {};
+	protected bool m_bNeedsScoring;
+	
+	//------------------------------------------------------------------------------------------------
+	void Enqueue(IEntity entity)
+	{
+		if (!entity)
+			return;
+		
+		AFM_DiDDespawnEntry entry = new AFM_DiDDespawnEntry();
+		entry.m_Entity = entity;
+		m_aEntries.Insert(entry);
+		m_bNeedsScoring = true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Delete up to maxEntities entities, returns number of deleted entities
+	//! @param observers Alive defenders used for ordering and visibility
+	//! @param visibleDistance Entities closer than this and in front of an observer are deferred
+	//! @param maxDeferSeconds Deferred entities are deleted anyway after this time
+	//------------------------------------------------------------------------------------------------
+	int Process(int maxEntities, array<IEntity> observers, float visibleDistance, float maxDeferSeconds)
+	{
+		if (m_aEntries.IsEmpty())
+			return 0;
+		
+		if (m_bNeedsScoring)
+			Score(observers);
+		
+		ChimeraWorld world = GetGame().GetWorld();
+		WorldTimestamp now = world.GetServerTimestamp();
+		float visibleDistanceSq = visibleDistance * visibleDistance;
+		
+		int deleted = 0;
+		int checkedThisFrame = 0;
+		while (deleted < maxEntities && checkedThisFrame < m_aEntries.Count())
+		{
+			int index = FindFarthest();
+			AFM_DiDDespawnEntry entry = m_aEntries[index];
+			
+			if (!entry.m_Entity)
+			{
+				m_aEntries.Remove(index);
+				continue;
+			}
+			
+			if (entry.m_fDistanceSq < visibleDistanceSq && IsObserved(entry.m_Entity, observers, visibleDistanceSq))
+			{
+				if (!entry.m_bDeferred)
+				{
+					entry.m_bDeferred = true;
+					entry.m_fFirstDeferTime = now;
+				}
+				
+				if (now.DiffSeconds(entry.m_fFirstDeferTime) < maxDeferSeconds)
+				{
+					// Skip for the rest of this frame
+					entry.m_fDistanceSq = -1;
+					checkedThisFrame++;
+					continue;
+				}
+			}
+			
+			SCR_EntityHelper.DeleteEntityAndChildren(entry.m_Entity);
+			m_aEntries.Remove(index);
+			deleted++;
+		}
+		
+		// Deferred entries are ordered again next frame
+		if (checkedThisFrame > 0)
+			m_bNeedsScoring = true;
+		
+		return deleted;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Delete everything right away
+	//------------------------------------------------------------------------------------------------
+	void Flush()
+	{
+		foreach (AFM_DiDDespawnEntry entry : m_aEntries)
+		{
+			if (entry.m_Entity)
+				SCR_EntityHelper.DeleteEntityAndChildren(entry.m_Entity);
+		}
+		m_aEntries.Clear();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool IsBusy()
+	{
+		return !m_aEntries.IsEmpty();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int Count()
+	{
+		return m_aEntries.Count();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Distance to the nearest observer, computed once per entry and again for deferred ones
+	//------------------------------------------------------------------------------------------------
+	protected void Score(array<IEntity> observers)
+	{
+		foreach (AFM_DiDDespawnEntry entry : m_aEntries)
+		{
+			if (entry.m_bScored && entry.m_fDistanceSq >= 0)
+				continue;
+			
+			entry.m_bScored = true;
+			entry.m_fDistanceSq = float.MAX;
+			if (!entry.m_Entity)
+				continue;
+			
+			vector pos = entry.m_Entity.GetOrigin();
+			foreach (IEntity observer : observers)
+			{
+				if (observer)
+					entry.m_fDistanceSq = Math.Min(entry.m_fDistanceSq, vector.DistanceSq(pos, observer.GetOrigin()));
+			}
+		}
+		
+		m_bNeedsScoring = false;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected int FindFarthest()
+	{
+		int best = 0;
+		for (int i = 1; i < m_aEntries.Count(); i++)
+		{
+			if (m_aEntries[i].m_fDistanceSq > m_aEntries[best].m_fDistanceSq)
+				best = i;
+		}
+		return best;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Cheap visibility estimate, entity is within distance and in front of the observer
+	//------------------------------------------------------------------------------------------------
+	protected bool IsObserved(IEntity entity, array<IEntity> observers, float visibleDistanceSq)
+	{
+		vector pos = entity.GetOrigin();
+		foreach (IEntity observer : observers)
+		{
+			if (!observer)
+				continue;
+			
+			vector toEntity = pos - observer.GetOrigin();
+			if (toEntity.LengthSq() > visibleDistanceSq)
+				continue;
+			
+			if (vector.Dot(toEntity, observer.GetTransformAxis(2)) >= 0)
+				return true;
+		}
+		return false;
+	}
+}
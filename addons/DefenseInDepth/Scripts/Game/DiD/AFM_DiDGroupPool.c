@@ -0,0 +1,263 @@
+//------------------------------------------------------------------------------------------------
+//! Group parked in the pool
+//------------------------------------------------------------------------------------------------
+class AFM_DiDParkedGroup
+{
+	AIGroup m_Group;
+	
+	// Zone the group was staged for, -1 for survivors any zone may reuse
+	int m_iZoneIndex;
+}
+
+//------------------------------------------------------------------------------------------------
+//! Pool of surviving attacker groups parked between zones
+//! Parked groups are moved to a holding area with AI and simulation switched off, the next
+//! spawn of the same prefab reuses them instead of creating and replicating new entities
+//------------------------------------------------------------------------------------------------
+class AFM_DiDGroupPool
+{
+	// Spacing between parked or reused members
+	protected static const float MEMBER_SPACING = 1.5;
+	
+	// Slots of the held member grid per side, staged groups are parked long before it wraps
+	protected static const int HELD_GRID_SIZE = 16;
+	
+	protected ref map<ResourceName, ref array<ref AFM_DiDParkedGroup>> m_mParkedGroups = new map<ResourceName, ref array<ref AFM_DiDParkedGroup>>();
+	protected vector m_vHoldingPosition;
+	protected int m_iMaxGroups;
+	protected int m_iCount;
+	
+	// Members held by HoldMember so far, each gets its own slot in a grid beside the parked groups
+	protected int m_iHeldMembers;
+	
+	//------------------------------------------------------------------------------------------------
+	void AFM_DiDGroupPool(vector holdingPosition, int maxGroups)
+	{
+		m_vHoldingPosition = holdingPosition;
+		m_iMaxGroups = maxGroups;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Park group in the holding area, returns false when group cannot be pooled
+	//! @param zoneIndex Only this zone may acquire the group, -1 for any zone
+	//------------------------------------------------------------------------------------------------
+	bool Park(AIGroup group, int zoneIndex = -1)
+	{
+		if (!group || group.GetAgentsCount() == 0)
+			return false;
+		
+		if (m_iMaxGroups > 0 && m_iCount >= m_iMaxGroups)
+			return false;
+		
+		ResourceName prefab = GetGroupPrefab(group);
+		if (prefab.IsEmpty())
+			return false;
+		
+		array<AIWaypoint> waypoints = {};
+		group.GetWaypoints(waypoints);
+		foreach (AIWaypoint waypoint : waypoints)
+		{
+			group.RemoveWaypoint(waypoint);
+		}
+		
+		// Parked members are no attackers, registry picks them up again on reuse
+		SCR_AIGroup scrGroup = SCR_AIGroup.Cast(group);
+		if (scrGroup)
+			scrGroup.SetAttackerRegistry(null);
+		
+		AFM_DiDAttackerRegistry registry = AFM_DiDZoneSystem.GetInstance().GetAttackerRegistry();
+		
+		vector transform[4];
+		Math3D.MatrixIdentity4(transform);
+		transform[3] = m_vHoldingPosition + Vector(m_iCount * MEMBER_SPACING * 4, 0, 0);
+		
+		array<AIAgent> agents = {};
+		group.GetAgents(agents);
+		foreach (AIAgent agent : agents)
+		{
+			registry.Unregister(agent);
+			agent.DeactivateAI();
+			SetMemberActive(agent.GetControlledEntity(), transform, false);
+		}
+		
+		array<ref AFM_DiDParkedGroup> parked = m_mParkedGroups.Get(prefab);
+		if (!parked)
+		{
+			parked = {};
+			m_mParkedGroups.Insert(prefab, parked);
+		}
+		
+		AFM_DiDParkedGroup entry = new AFM_DiDParkedGroup();
+		entry.m_Group = group;
+		entry.m_iZoneIndex = zoneIndex;
+		parked.Insert(entry);
+		m_iCount++;
+		
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Switch member of a group being staged off right as it spawns, Park finishes the job
+	//! once all members are in
+	//------------------------------------------------------------------------------------------------
+	void HoldMember(AIAgent agent)
+	{
+		if (!agent)
+			return;
+		
+		vector transform[4];
+		Math3D.MatrixIdentity4(transform);
+		int slot = m_iHeldMembers % (HELD_GRID_SIZE * HELD_GRID_SIZE);
+		float column = slot % HELD_GRID_SIZE;
+		float row = slot / HELD_GRID_SIZE + 1;
+		transform[3] = m_vHoldingPosition + Vector(column * MEMBER_SPACING, 0, -row * MEMBER_SPACING * 4);
+		m_iHeldMembers++;
+		
+		agent.DeactivateAI();
+		SetMemberActive(agent.GetControlledEntity(), transform, false);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Take parked group of given prefab and place it at spawn point, null when none is parked
+	//! @param zoneIndex Zone asking, groups staged for other zones are left alone
+	//------------------------------------------------------------------------------------------------
+	AIGroup Acquire(ResourceName prefab, IEntity spawnPoint, int zoneIndex)
+	{
+		array<ref AFM_DiDParkedGroup> parked = m_mParkedGroups.Get(prefab);
+		if (!parked)
+			return null;
+		
+		for (int i = parked.Count() - 1; i >= 0; i--)
+		{
+			AFM_DiDParkedGroup entry = parked[i];
+			if (entry.m_iZoneIndex != -1 && entry.m_iZoneIndex != zoneIndex)
+				continue;
+			
+			AIGroup group = entry.m_Group;
+			parked.RemoveOrdered(i);
+			m_iCount--;
+			
+			// Members may have been deleted while parked
+			if (!group || group.GetAgentsCount() == 0)
+				continue;
+			
+			vector transform[4];
+			spawnPoint.GetWorldTransform(transform);
+			group.SetOrigin(transform[3]);
+			
+			array<AIAgent> agents = {};
+			group.GetAgents(agents);
+			foreach (AIAgent agent : agents)
+			{
+				SetMemberActive(agent.GetControlledEntity(), transform, true);
+				agent.ActivateAI();
+			}
+			
+			return group;
+		}
+		
+		return null;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Let any zone reuse groups staged for given zone, called when that zone is deactivated
+	//------------------------------------------------------------------------------------------------
+	void ReleaseZone(int zoneIndex)
+	{
+		foreach (ResourceName prefab, array<ref AFM_DiDParkedGroup> parked : m_mParkedGroups)
+		{
+			foreach (AFM_DiDParkedGroup entry : parked)
+			{
+				if (entry.m_iZoneIndex == zoneIndex)
+					entry.m_iZoneIndex = -1;
+			}
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	vector GetHoldingPosition()
+	{
+		return m_vHoldingPosition;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int Count()
+	{
+		return m_iCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Delete all parked groups
+	//------------------------------------------------------------------------------------------------
+	void Clear()
+	{
+		foreach (ResourceName prefab, array<ref AFM_DiDParkedGroup> parked : m_mParkedGroups)
+		{
+			foreach (AFM_DiDParkedGroup entry : parked)
+			{
+				AIGroup group = entry.m_Group;
+				if (!group)
+					continue;
+				
+				array<AIAgent> agents = {};
+				group.GetAgents(agents);
+				foreach (AIAgent agent : agents)
+				{
+					if (agent)
+						SCR_EntityHelper.DeleteEntityAndChildren(agent.GetControlledEntity());
+				}
+				SCR_EntityHelper.DeleteEntityAndChildren(group);
+			}
+		}
+		m_mParkedGroups.Clear();
+		m_iCount = 0;
+		m_iHeldMembers = 0;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Move member next to transform origin and switch its simulation on or off
+	//! transform origin is advanced so members do not end up inside each other
+	//------------------------------------------------------------------------------------------------
+	protected void SetMemberActive(IEntity member, inout vector transform[4], bool active)
+	{
+		if (!member)
+			return;
+		
+		BaseGameEntity gameEntity = BaseGameEntity.Cast(member);
+		if (gameEntity)
+			gameEntity.Teleport(transform);
+		else
+			member.SetWorldTransform(transform);
+		
+		transform[3] = transform[3] + transform[0] * MEMBER_SPACING;
+		
+		Physics physics = member.GetPhysics();
+		if (active)
+		{
+			member.SetFlags(EntityFlags.ACTIVE, true);
+			if (physics)
+				physics.SetActive(ActiveState.ACTIVE);
+			
+			// Survivors come back at full strength
+			SCR_CharacterDamageManagerComponent damageManager = SCR_CharacterDamageManagerComponent.Cast(member.FindComponent(SCR_CharacterDamageManagerComponent));
+			if (damageManager)
+				damageManager.FullHeal();
+		}
+		else
+		{
+			if (physics)
+				physics.SetActive(ActiveState.INACTIVE);
+			member.ClearFlags(EntityFlags.ACTIVE, true);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected ResourceName GetGroupPrefab(AIGroup group)
+	{
+		EntityPrefabData prefabData = group.GetPrefabData();
+		if (!prefabData)
+			return ResourceName.Empty;
+		
+		return prefabData.GetPrefabName();
+	}
+}
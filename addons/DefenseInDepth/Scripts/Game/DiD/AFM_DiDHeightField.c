@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------------------------
+//! Terrain heights sampled on a regular grid over the zone bounding box
+//! Built once per zone activation, per sample terrain queries then use a bilinear lookup
+//! instead of asking the world. Final placement should still use the exact world query.
+//! Build queries the world once per grid point in one frame, off unless a zone sets a cell size
+//------------------------------------------------------------------------------------------------
+class AFM_DiDHeightField
+{
+	protected const int MAX_GRID_POINTS = 262144;
+	
+	protected float m_fCellSize;
+	protected float m_fMinX;
+	protected float m_fMinZ;
+	
+	// Grid points per axis, point index = row * width + col
+	protected int m_iWidth;
+	protected int m_iHeight;
+	protected ref array<float> m_aHeights = {};
+	
+	//------------------------------------------------------------------------------------------------
+	//! Sample terrain over bounds extended by one cell, returns false when the grid would be too large
+	//------------------------------------------------------------------------------------------------
+	bool Build(vector minBounds, vector maxBounds, float cellSize)
+	{
+		Release();
+		
+		if (cellSize <= 0)
+			return false;
+		
+		float minX = minBounds[0] - cellSize;
+		float minZ = minBounds[2] - cellSize;
+		int width = Math.Ceil((maxBounds[0] + cellSize - minX) / cellSize) + 1;
+		int height = Math.Ceil((maxBounds[2] + cellSize - minZ) / cellSize) + 1;
+		if (width * height > MAX_GRID_POINTS)
+			return false;
+		
+		BaseWorld world = GetGame().GetWorld();
+		m_aHeights.Resize(width * height);
+		for (int row = 0; row < height; row++)
+		{
+			float z = minZ + row * cellSize;
+			for (int col = 0; col < width; col++)
+			{
+				m_aHeights[row * width + col] = world.GetSurfaceY(minX + col * cellSize, z);
+			}
+		}
+		
+		m_fCellSize = cellSize;
+		m_fMinX = minX;
+		m_fMinZ = minZ;
+		m_iWidth = width;
+		m_iHeight = height;
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void Release()
+	{
+		m_aHeights.Clear();
+		m_iWidth = 0;
+		m_iHeight = 0;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool IsBuilt()
+	{
+		return m_iWidth > 0;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool IsInBounds(float x, float z)
+	{
+		if (!IsBuilt())
+			return false;
+		
+		float col = (x - m_fMinX) / m_fCellSize;
+		float row = (z - m_fMinZ) / m_fCellSize;
+		return col >= 0 && row >= 0 && col <= m_iWidth - 1 && row <= m_iHeight - 1;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Bilinear interpolated terrain height, only valid where IsInBounds is true
+	//------------------------------------------------------------------------------------------------
+	float GetHeight(float x, float z)
+	{
+		float col = (x - m_fMinX) / m_fCellSize;
+		float row = (z - m_fMinZ) / m_fCellSize;
+		
+		// Clamp so points on the far border still have a cell to interpolate in
+		int col0 = Math.Clamp(Math.Floor(col), 0, m_iWidth - 2);
+		int row0 = Math.Clamp(Math.Floor(row), 0, m_iHeight - 2);
+		float tx = Math.Clamp(col - col0, 0, 1);
+		float tz = Math.Clamp(row - row0, 0, 1);
+		
+		int index = row0 * m_iWidth + col0;
+		float h00 = m_aHeights[index];
+		float h10 = m_aHeights[index + 1];
+		float h01 = m_aHeights[index + m_iWidth];
+		float h11 = m_aHeights[index + m_iWidth + 1];
+		
+		float bottom = h00 + (h10 - h00) * tx;
+		float top = h01 + (h11 - h01) * tx;
+		return bottom + (top - bottom) * tz;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int GetPointCount()
+	{
+		return m_aHeights.Count();
+	}
+}
\ No newline at end of file
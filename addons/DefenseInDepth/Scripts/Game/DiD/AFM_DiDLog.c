@@ -0,0 +1,209 @@
+//------------------------------------------------------------------------------------------------
+enum EAFMDiDLogCategory
+{
+	SYSTEM,
+	ZONE,
+	SPAWNER,
+	MORTAR,
+	CREW
+}
+
+//------------------------------------------------------------------------------------------------
+//! Logging facade with per category verbosity
+//! Check IsEnabled before building the message so disabled lines cost a single comparison:
+//!   if (AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG))
+//!     AFM_DiDLog.Write(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG, string.Format(...));
+//! Levels are set from the game mode attribute, the -didLog CLI parameter overrides it.
+//! Format: "spawner=debug,mortar=verbose" or a single level for all categories, e.g. "debug"
+//! With the ring buffer enabled, lines below the print level are kept in memory and only
+//! written to the log right before the next error written through Write.
+//! IsEnabled then returns true for buffered levels in every category, so those lines are
+//! formatted even when they are never printed - keep the buffer off when that cost matters
+//------------------------------------------------------------------------------------------------
+class AFM_DiDLog
+{
+	protected static const string CLI_PARAM = "didLog";
+	
+	// Number of EAFMDiDLogCategory values
+	protected static const int CATEGORY_COUNT = 5;
+	
+	// Lowest printed level per category
+	protected static ref array<LogLevel> s_aLevels;
+	
+	// Lowest buffered level, only used when the ring buffer is enabled
+	protected static LogLevel s_eBufferLevel = LogLevel.DEBUG;
+	protected static ref array<string> s_aBuffer;
+	protected static int s_iBufferSize;
+	protected static int s_iBufferNext;
+	
+	//------------------------------------------------------------------------------------------------
+	//! Set category levels from config string, -didLog CLI parameter takes precedence
+	//! @param bufferSize Lines kept in the ring buffer (0 = disabled)
+	//------------------------------------------------------------------------------------------------
+	static void Init(string config, int bufferSize)
+	{
+		ResetLevels();
+		
+		string cliConfig;
+		if (System.GetCLIParam(CLI_PARAM, cliConfig))
+			config = cliConfig;
+		
+		ParseConfig(config);
+		
+		s_iBufferSize = Math.Max(0, bufferSize);
+		s_iBufferNext = 0;
+		s_aBuffer = null;
+		if (s_iBufferSize > 0)
+			s_aBuffer = {};
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static bool IsEnabled(EAFMDiDLogCategory category, LogLevel level)
+	{
+		if (!s_aLevels)
+			ResetLevels();
+		
+		if (level >= s_aLevels[category])
+			return true;
+		
+		return s_aBuffer && level >= s_eBufferLevel;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static void Write(EAFMDiDLogCategory category, LogLevel level, string message)
+	{
+		if (!s_aLevels)
+			ResetLevels();
+		
+		if (level < s_aLevels[category])
+		{
+			if (s_aBuffer && level >= s_eBufferLevel)
+				Buffer(message);
+			return;
+		}
+		
+		// Give context to the error with what was suppressed before it
+		if (level >= LogLevel.ERROR)
+			FlushBuffer();
+		
+		Print(message, level);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Print buffered lines in order and clear the buffer
+	//------------------------------------------------------------------------------------------------
+	static void FlushBuffer()
+	{
+		if (!s_aBuffer || s_aBuffer.IsEmpty())
+			return;
+		
+		int count = s_aBuffer.Count();
+		int start = 0;
+		if (count == s_iBufferSize)
+			start = s_iBufferNext;
+		
+		Print("AFM_DiDLog: Buffered lines before error:", LogLevel.NORMAL);
+		for (int i = 0; i < count; i++)
+		{
+			Print(s_aBuffer[(start + i) % count], LogLevel.NORMAL);
+		}
+		
+		s_aBuffer.Clear();
+		s_iBufferNext = 0;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static void Buffer(string message)
+	{
+		if (s_aBuffer.Count() < s_iBufferSize)
+			s_aBuffer.Insert(message);
+		else
+			s_aBuffer[s_iBufferNext] = message;
+		
+		s_iBufferNext = (s_iBufferNext + 1) % s_iBufferSize;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static void ResetLevels()
+	{
+		s_aLevels = {};
+		for (int i = 0; i < CATEGORY_COUNT; i++)
+		{
+			s_aLevels.Insert(LogLevel.NORMAL);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static void ParseConfig(string config)
+	{
+		config.Replace(" ", "");
+		config.ToLower();
+		if (config.IsEmpty())
+			return;
+		
+		array<string> entries = {};
+		config.Split(",", entries, true);
+		foreach (string entry : entries)
+		{
+			array<string> pair = {};
+			entry.Split("=", pair, true);
+			
+			LogLevel parsedLevel;
+			if (pair.Count() == 1 && ParseLevel(pair[0], parsedLevel))
+			{
+				for (int i = 0; i < s_aLevels.Count(); i++)
+				{
+					s_aLevels[i] = parsedLevel;
+				}
+				continue;
+			}
+			
+			if (pair.Count() != 2 || !ParseLevel(pair[1], parsedLevel))
+			{
+				PrintFormat("AFM_DiDLog: Invalid log config entry '%1'", entry, level: LogLevel.WARNING);
+				continue;
+			}
+			
+			string categoryName = pair[0];
+			categoryName.ToUpper();
+			int category = typename.StringToEnum(EAFMDiDLogCategory, categoryName);
+			if (category < 0 || category >= s_aLevels.Count())
+			{
+				PrintFormat("AFM_DiDLog: Unknown log category '%1'", pair[0], level: LogLevel.WARNING);
+				continue;
+			}
+			
+			s_aLevels[category] = parsedLevel;
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static bool ParseLevel(string name, out LogLevel level)
+	{
+		switch (name)
+		{
+			case "spam":
+				level = LogLevel.SPAM;
+				return true;
+			case "verbose":
+				level = LogLevel.VERBOSE;
+				return true;
+			case "debug":
+				level = LogLevel.DEBUG;
+				return true;
+			case "normal":
+				level = LogLevel.NORMAL;
+				return true;
+			case "warning":
+				level = LogLevel.WARNING;
+				return true;
+			case "error":
+				level = LogLevel.ERROR;
+				return true;
+			case "fatal":
+				level = LogLevel.FATAL;
+				return true;
+		}
+		return false;
+	}
+}
\ No newline at end of file
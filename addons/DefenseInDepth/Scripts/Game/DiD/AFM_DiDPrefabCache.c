@@ -0,0 +1,62 @@
+//------------------------------------------------------------------------------------------------
+//! Keeps prefab resources used by DiD spawners loaded for the whole mission
+//! Zones preload their spawner prefabs during PREPARE so the first wave doesn't stall on loads
+//------------------------------------------------------------------------------------------------
+class AFM_DiDPrefabCache
+{
+	protected ref map<ResourceName, ref Resource> m_mResources = new map<ResourceName, ref Resource>();
+	
+	//------------------------------------------------------------------------------------------------
+	//! Get resource from the mission cache, falls back to plain load when the zone system is missing
+	//------------------------------------------------------------------------------------------------
+	static Resource Load(ResourceName prefab)
+	{
+		AFM_DiDZoneSystem zoneSystem = AFM_DiDZoneSystem.GetInstance();
+		if (!zoneSystem)
+			return Resource.Load(prefab);
+		
+		return zoneSystem.GetPrefabCache().Get(prefab);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Get cached resource, loading and keeping it on first use
+	//------------------------------------------------------------------------------------------------
+	Resource Get(ResourceName prefab)
+	{
+		Resource resource = m_mResources.Get(prefab);
+		if (resource)
+			return resource;
+		
+		resource = Resource.Load(prefab);
+		if (!resource || !resource.IsValid())
+		{
+			AFM_DiDLog.Write(EAFMDiDLogCategory.SYSTEM, LogLevel.ERROR, string.Format("AFM_DiDPrefabCache: Failed to load %1", prefab));
+			return null;
+		}
+		
+		m_mResources.Set(prefab, resource);
+		return resource;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void Preload(notnull array<ResourceName> prefabs)
+	{
+		foreach (ResourceName prefab : prefabs)
+		{
+			if (!prefab.IsEmpty())
+				Get(prefab);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool Contains(ResourceName prefab)
+	{
+		return m_mResources.Contains(prefab);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void Clear()
+	{
+		m_mResources.Clear();
+	}
+}
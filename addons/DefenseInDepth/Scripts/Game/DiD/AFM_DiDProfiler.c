@@ -0,0 +1,195 @@
+//------------------------------------------------------------------------------------------------
+//! Timing totals of a single profiler scope
+//! Calls are summed per interval, the window keeps the last interval totals. Summing millisecond
+//! ticks stays unbiased even when single calls are far below a millisecond
+//------------------------------------------------------------------------------------------------
+class AFM_DiDProfilerScope
+{
+	// Totals in ms and call counts of closed intervals
+	protected ref array<float> m_aIntervalTotals = {};
+	protected ref array<int> m_aIntervalCalls = {};
+	protected int m_iWindowSize;
+	protected int m_iNext;
+	
+	protected float m_fPendingMs;
+	protected int m_iPendingCalls;
+	protected int m_iTotalCount;
+	
+	//------------------------------------------------------------------------------------------------
+	void AFM_DiDProfilerScope(int windowSize)
+	{
+		m_iWindowSize = Math.Max(1, windowSize);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void AddSample(float ms)
+	{
+		m_fPendingMs += ms;
+		m_iPendingCalls++;
+		m_iTotalCount++;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Move totals of the running interval into the window
+	//------------------------------------------------------------------------------------------------
+	void CloseInterval()
+	{
+		if (m_aIntervalTotals.Count() < m_iWindowSize)
+		{
+			m_aIntervalTotals.Insert(m_fPendingMs);
+			m_aIntervalCalls.Insert(m_iPendingCalls);
+		}
+		else
+		{
+			m_aIntervalTotals[m_iNext] = m_fPendingMs;
+			m_aIntervalCalls[m_iNext] = m_iPendingCalls;
+		}
+		
+		m_iNext = (m_iNext + 1) % m_iWindowSize;
+		m_fPendingMs = 0;
+		m_iPendingCalls = 0;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Stats over the window, returns false when no call fell into it
+	//! @param[out] perCall Mean ms per call
+	//! @param[out] mean, p95, max Ms spent per interval
+	//------------------------------------------------------------------------------------------------
+	bool GetStats(out float perCall, out float mean, out float p95, out float max)
+	{
+		int count = m_aIntervalTotals.Count();
+		if (count == 0)
+			return false;
+		
+		int calls = 0;
+		foreach (int intervalCalls : m_aIntervalCalls)
+		{
+			calls += intervalCalls;
+		}
+		
+		if (calls == 0)
+			return false;
+		
+		array<float> sorted = {};
+		sorted.Copy(m_aIntervalTotals);
+		sorted.Sort();
+		
+		float sum = 0;
+		foreach (float total : sorted)
+		{
+			sum += total;
+		}
+		
+		perCall = sum / calls;
+		mean = sum / count;
+		p95 = sorted[Math.Min(count - 1, Math.Ceil(count * 0.95) - 1)];
+		max = sorted[count - 1];
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Calls recorded since the last reset, including those that left the window
+	//------------------------------------------------------------------------------------------------
+	int GetTotalCount()
+	{
+		return m_iTotalCount;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//! Named timing scopes of the zone system
+//! Usage: int start = profiler.Begin(); ... profiler.End("census", start);
+//! Timing uses the millisecond system tick, so stats are reported as time spent per interval
+//! (CloseInterval, once per second from the zone system) and mean time per call
+//------------------------------------------------------------------------------------------------
+class AFM_DiDProfiler
+{
+	protected ref map<string, ref AFM_DiDProfilerScope> m_mScopes = new map<string, ref AFM_DiDProfilerScope>();
+	protected int m_iWindowSize;
+	
+	//------------------------------------------------------------------------------------------------
+	void AFM_DiDProfiler(int windowSize)
+	{
+		m_iWindowSize = windowSize;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Start of a measured scope, pass the result to End
+	//------------------------------------------------------------------------------------------------
+	int Begin()
+	{
+		return System.GetTickCount();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void End(string scope, int startTick)
+	{
+		AddSample(scope, System.GetTickCount() - startTick);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void AddSample(string scope, float ms)
+	{
+		AFM_DiDProfilerScope profilerScope = m_mScopes.Get(scope);
+		if (!profilerScope)
+		{
+			profilerScope = new AFM_DiDProfilerScope(m_iWindowSize);
+			m_mScopes.Insert(scope, profilerScope);
+		}
+		
+		profilerScope.AddSample(ms);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Close running interval of all scopes
+	//------------------------------------------------------------------------------------------------
+	void CloseInterval()
+	{
+		foreach (string name, AFM_DiDProfilerScope scope : m_mScopes)
+		{
+			scope.CloseInterval();
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! One line per scope with mean ms per call and mean, p95 and max ms per interval
+	//------------------------------------------------------------------------------------------------
+	void Dump(notnull array<string> outLines)
+	{
+		array<string> names = {};
+		foreach (string name, AFM_DiDProfilerScope scope : m_mScopes)
+		{
+			names.Insert(name);
+		}
+		names.Sort();
+		
+		foreach (string name : names)
+		{
+			float perCall, mean, p95, max;
+			AFM_DiDProfilerScope scope = m_mScopes.Get(name);
+			if (!scope.GetStats(perCall, mean, p95, max))
+				continue;
+			
+			outLines.Insert(string.Format("%1: n=%2 call=%3 interval mean=%4 p95=%5 max=%6", name, scope.GetTotalCount(), perCall.ToString(-1, 3), mean.ToString(-1, 2), p95, max));
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void PrintStats()
+	{
+		array<string> lines = {};
+		Dump(lines);
+		
+		Print("AFM_DiDProfiler: Zone system timings (ms)");
+		foreach (string line : lines)
+		{
+			Print("AFM_DiDProfiler: " + line);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void Reset()
+	{
+		m_mScopes.Clear();
+	}
+}
\ No newline at end of file
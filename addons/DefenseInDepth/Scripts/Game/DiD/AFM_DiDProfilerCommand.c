@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------------------------
+//! Admin command dumping zone system profiler stats
+//! #didprof - print stats, #didprof reset - clear all scopes
+//! #didprof bench [trials] - benchmark mortar targeting samplers of the active zone
+//------------------------------------------------------------------------------------------------
+class AFM_DiDProfilerCommand : ScrServerCommand
+{
+	//------------------------------------------------------------------------------------------------
+	override string GetKeyword()
+	{
+		return "didprof";
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	override bool IsServerSide()
+	{
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	override int RequiredRCONPermission()
+	{
+		return ERCONPermissions.PERMISSIONS_ADMIN;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	override int RequiredChatPermission()
+	{
+		return EPlayerRole.ADMINISTRATOR;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	override ref ScrServerCmdResult OnChatServerExecution(array<string> argv, int playerId)
+	{
+		return Execute(argv);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	override ref ScrServerCmdResult OnChatClientExecution(array<string> argv, int playerId)
+	{
+		return new ScrServerCmdResult(string.Empty, EServerCmdResultType.OK);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	override ref ScrServerCmdResult OnRCONExecution(array<string> argv)
+	{
+		return Execute(argv);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	override ref ScrServerCmdResult OnUpdate()
+	{
+		return new ScrServerCmdResult(string.Empty, EServerCmdResultType.OK);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected ScrServerCmdResult Execute(array<string> argv)
+	{
+		AFM_DiDZoneSystem zoneSystem = AFM_DiDZoneSystem.GetInstance();
+		if (!zoneSystem)
+			return new ScrServerCmdResult("Zone system is not running", EServerCmdResultType.ERR);
+		
+		if (argv.Count() > 1 && argv[1] == "bench")
+			return ExecuteBenchmark(zoneSystem, argv);
+		
+		AFM_DiDProfiler profiler = zoneSystem.GetProfiler();
+		if (argv.Count() > 1 && argv[1] == "reset")
+		{
+			profiler.Reset();
+			return new ScrServerCmdResult("Profiler reset", EServerCmdResultType.OK);
+		}
+		
+		array<string> lines = {};
+		profiler.Dump(lines);
+		profiler.PrintStats();
+		
+		if (lines.IsEmpty())
+			return new ScrServerCmdResult("No samples yet", EServerCmdResultType.OK);
+		
+		return new ScrServerCmdResult(JoinLines(lines), EServerCmdResultType.OK);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected ScrServerCmdResult ExecuteBenchmark(AFM_DiDZoneSystem zoneSystem, array<string> argv)
+	{
+		AFM_DiDZoneComponent zone = zoneSystem.GetActiveZone();
+		if (!zone)
+			return new ScrServerCmdResult("No active zone", EServerCmdResultType.ERR);
+		
+		int trials = 20;
+		if (argv.Count() > 2)
+			trials = Math.Max(1, argv[2].ToInt());
+		
+		array<AFM_DiDSpawnerComponent> spawners = {};
+		zone.GetSpawners(spawners);
+		
+		array<string> lines = {};
+		foreach (AFM_DiDSpawnerComponent spawner : spawners)
+		{
+			AFM_DiDMortarSpawnerComponent mortarSpawner = AFM_DiDMortarSpawnerComponent.Cast(spawner);
+			if (mortarSpawner)
+				mortarSpawner.BenchmarkTargeting(trials, lines);
+		}
+		
+		if (lines.IsEmpty())
+			return new ScrServerCmdResult("No mortar spawner in active zone", EServerCmdResultType.OK);
+		
+		foreach (string line : lines)
+		{
+			Print(line);
+		}
+		return new ScrServerCmdResult(JoinLines(lines), EServerCmdResultType.OK);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected string JoinLines(array<string> lines)
+	{
+		string result;
+		foreach (string line : lines)
+		{
+			result += line + "\n";
+		}
+		return result;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,332 @@
+//------------------------------------------------------------------------------------------------
+//! Zone polygon triangulated for uniform sampling
+//! Triangles are picked by area through a cumulative table, so every sample lies inside the
+//! polygon. Large triangles are split so that clipping to a range annulus stays tight
+//------------------------------------------------------------------------------------------------
+class AFM_DiDSamplingDomain
+{
+	protected const int MAX_TRIANGLES = 4096;
+	
+	// Flat world space buffer [ax, az, bx, bz, cx, cz, ...], 6 floats per triangle
+	protected ref array<float> m_aTriangles = {};
+	
+	// Running sum of triangle areas, last entry is the area of the whole domain
+	protected ref array<float> m_aCumulativeArea = {};
+	
+	//------------------------------------------------------------------------------------------------
+	//! Triangulate polygon by ear clipping, returns false when the outline can not be fully triangulated
+	//! @param polygon Flat 2D buffer [x0, z0, x1, z1, ...] as kept by AFM_DiDZoneGeometry
+	//! @param maxEdge Triangles with a longer edge are split (0 = no split)
+	//------------------------------------------------------------------------------------------------
+	bool Build(array<float> polygon, float maxEdge)
+	{
+		m_aTriangles.Clear();
+		m_aCumulativeArea.Clear();
+		
+		int vertexCount = polygon.Count() / 2;
+		if (vertexCount < 3)
+			return false;
+		
+		float signedArea = GetSignedArea(polygon);
+		if (signedArea == 0)
+			return false;
+		
+		// Ears are convex corners in polygon winding order
+		float winding = 1;
+		if (signedArea < 0)
+			winding = -1;
+		
+		array<int> remaining = {};
+		for (int vertex = 0; vertex < vertexCount; vertex++)
+		{
+			remaining.Insert(vertex);
+		}
+		
+		while (remaining.Count() > 3)
+		{
+			int count = remaining.Count();
+			bool clipped = false;
+			for (int i = 0; i < count; i++)
+			{
+				int prev = remaining[(i + count - 1) % count];
+				int next = remaining[(i + 1) % count];
+				if (!IsEar(polygon, remaining, prev, remaining[i], next, winding))
+					continue;
+				
+				AddTriangle(polygon[prev * 2], polygon[prev * 2 + 1], polygon[remaining[i] * 2], polygon[remaining[i] * 2 + 1], polygon[next * 2], polygon[next * 2 + 1], maxEdge);
+				remaining.RemoveOrdered(i);
+				clipped = true;
+				break;
+			}
+			
+			// Self intersecting outline, a partial triangulation would leave parts of the zone unsampled
+			if (!clipped)
+			{
+				m_aTriangles.Clear();
+				m_aCumulativeArea.Clear();
+				return false;
+			}
+		}
+		
+		if (remaining.Count() == 3)
+			AddTriangle(polygon[remaining[0] * 2], polygon[remaining[0] * 2 + 1], polygon[remaining[1] * 2], polygon[remaining[1] * 2 + 1], polygon[remaining[2] * 2], polygon[remaining[2] * 2 + 1], maxEdge);
+		
+		return !IsEmpty();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! New domain with triangles that may reach into the ring between minRange and maxRange around center
+	//! Triangles are kept whole, samples close to the ring border still need a range check
+	//------------------------------------------------------------------------------------------------
+	AFM_DiDSamplingDomain ClipToAnnulus(vector center, float minRange, float maxRange)
+	{
+		AFM_DiDSamplingDomain clipped = new AFM_DiDSamplingDomain();
+		
+		float minRangeSq = minRange * minRange;
+		float maxRangeSq = maxRange * maxRange;
+		float cx = center[0];
+		float cz = center[2];
+		
+		int triangleCount = GetTriangleCount();
+		for (int i = 0; i < triangleCount; i++)
+		{
+			int offset = i * 6;
+			float ax = m_aTriangles[offset];
+			float az = m_aTriangles[offset + 1];
+			float bx = m_aTriangles[offset + 2];
+			float bz = m_aTriangles[offset + 3];
+			float tx = m_aTriangles[offset + 4];
+			float tz = m_aTriangles[offset + 5];
+			
+			// Circle is convex, triangle with all corners inside is too close as a whole
+			if (GetDistanceSq(cx, cz, ax, az) < minRangeSq && GetDistanceSq(cx, cz, bx, bz) < minRangeSq && GetDistanceSq(cx, cz, tx, tz) < minRangeSq)
+				continue;
+			
+			if (GetTriangleDistanceSq(cx, cz, ax, az, bx, bz, tx, tz) > maxRangeSq)
+				continue;
+			
+			clipped.InsertTriangle(ax, az, bx, bz, tx, tz);
+		}
+		
+		return clipped;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Uniformly distributed point inside the domain, Y is left at 0
+	//------------------------------------------------------------------------------------------------
+	vector Sample(notnull RandomGenerator random)
+	{
+		return MapPoint(random.RandFloat01(), random.RandFloat01(), random.RandFloat01());
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Map point of the unit cube onto the domain, Y is left at 0
+	//! Evenly spread inputs give evenly spread points, see AFM_DiDTargetSampler
+	//! @param selector Picks the triangle by area
+	//! @param u, v Position inside the triangle
+	//------------------------------------------------------------------------------------------------
+	vector MapPoint(float selector, float u, float v)
+	{
+		if (IsEmpty())
+			return vector.Zero;
+		
+		float target = Math.Clamp(selector, 0, 1) * GetArea();
+		
+		// First triangle whose running area exceeds target
+		int low = 0;
+		int high = m_aCumulativeArea.Count() - 1;
+		while (low < high)
+		{
+			int mid = (low + high) / 2;
+			if (m_aCumulativeArea[mid] <= target)
+				low = mid + 1;
+			else
+				high = mid;
+		}
+		
+		// Fold unit square onto the triangle
+		if (u + v > 1)
+		{
+			u = 1 - u;
+			v = 1 - v;
+		}
+		
+		int offset = low * 6;
+		float ax = m_aTriangles[offset];
+		float az = m_aTriangles[offset + 1];
+		float x = ax + u * (m_aTriangles[offset + 2] - ax) + v * (m_aTriangles[offset + 4] - ax);
+		float z = az + u * (m_aTriangles[offset + 3] - az) + v * (m_aTriangles[offset + 5] - az);
+		return Vector(x, 0, z);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool IsEmpty()
+	{
+		return m_aCumulativeArea.IsEmpty();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	float GetArea()
+	{
+		if (m_aCumulativeArea.IsEmpty())
+			return 0;
+		
+		return m_aCumulativeArea[m_aCumulativeArea.Count() - 1];
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int GetTriangleCount()
+	{
+		return m_aTriangles.Count() / 6;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void InsertTriangle(float ax, float az, float bx, float bz, float cx, float cz)
+	{
+		float area = Math.AbsFloat((bx - ax) * (cz - az) - (cx - ax) * (bz - az)) * 0.5;
+		if (area <= 0)
+			return;
+		
+		m_aTriangles.Insert(ax);
+		m_aTriangles.Insert(az);
+		m_aTriangles.Insert(bx);
+		m_aTriangles.Insert(bz);
+		m_aTriangles.Insert(cx);
+		m_aTriangles.Insert(cz);
+		m_aCumulativeArea.Insert(GetArea() + area);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Insert triangle, splitting its longest edge until all edges are at most maxEdge
+	//------------------------------------------------------------------------------------------------
+	protected void AddTriangle(float ax, float az, float bx, float bz, float cx, float cz, float maxEdge)
+	{
+		float ab = GetDistanceSq(ax, az, bx, bz);
+		float bc = GetDistanceSq(bx, bz, cx, cz);
+		float ca = GetDistanceSq(cx, cz, ax, az);
+		float longest = Math.Max(ab, Math.Max(bc, ca));
+		
+		if (maxEdge <= 0 || longest <= maxEdge * maxEdge || GetTriangleCount() >= MAX_TRIANGLES)
+		{
+			InsertTriangle(ax, az, bx, bz, cx, cz);
+			return;
+		}
+		
+		if (longest == ab)
+		{
+			float abx = (ax + bx) * 0.5;
+			float abz = (az + bz) * 0.5;
+			AddTriangle(ax, az, abx, abz, cx, cz, maxEdge);
+			AddTriangle(abx, abz, bx, bz, cx, cz, maxEdge);
+		}
+		else if (longest == bc)
+		{
+			float bcx = (bx + cx) * 0.5;
+			float bcz = (bz + cz) * 0.5;
+			AddTriangle(ax, az, bx, bz, bcx, bcz, maxEdge);
+			AddTriangle(ax, az, bcx, bcz, cx, cz, maxEdge);
+		}
+		else
+		{
+			float cax = (cx + ax) * 0.5;
+			float caz = (cz + az) * 0.5;
+			AddTriangle(ax, az, bx, bz, cax, caz, maxEdge);
+			AddTriangle(cax, caz, bx, bz, cx, cz, maxEdge);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Corner is convex and no other remaining vertex lies inside the triangle it spans
+	//------------------------------------------------------------------------------------------------
+	protected bool IsEar(array<float> polygon, array<int> remaining, int prev, int current, int next, float winding)
+	{
+		float ax = polygon[prev * 2];
+		float az = polygon[prev * 2 + 1];
+		float bx = polygon[current * 2];
+		float bz = polygon[current * 2 + 1];
+		float cx = polygon[next * 2];
+		float cz = polygon[next * 2 + 1];
+		
+		if (GetCross(ax, az, bx, bz, cx, cz) * winding <= 0)
+			return false;
+		
+		foreach (int vertex : remaining)
+		{
+			if (vertex == prev || vertex == current || vertex == next)
+				continue;
+			
+			if (IsPointInTriangle(polygon[vertex * 2], polygon[vertex * 2 + 1], ax, az, bx, bz, cx, cz))
+				return false;
+		}
+		
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected float GetSignedArea(array<float> polygon)
+	{
+		float area;
+		int vertexCount = polygon.Count() / 2;
+		for (int i = 0; i < vertexCount; i++)
+		{
+			int j = (i + 1) % vertexCount;
+			area += polygon[i * 2] * polygon[j * 2 + 1] - polygon[j * 2] * polygon[i * 2 + 1];
+		}
+		return area * 0.5;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Z component of (b - a) x (c - b), positive for a counter clockwise turn
+	//------------------------------------------------------------------------------------------------
+	protected float GetCross(float ax, float az, float bx, float bz, float cx, float cz)
+	{
+		return (bx - ax) * (cz - bz) - (bz - az) * (cx - bx);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Inclusive test, points on an edge count as inside
+	//------------------------------------------------------------------------------------------------
+	protected bool IsPointInTriangle(float px, float pz, float ax, float az, float bx, float bz, float cx, float cz)
+	{
+		float d1 = GetCross(ax, az, bx, bz, px, pz);
+		float d2 = GetCross(bx, bz, cx, cz, px, pz);
+		float d3 = GetCross(cx, cz, ax, az, px, pz);
+		
+		bool hasNegative = d1 < 0 || d2 < 0 || d3 < 0;
+		bool hasPositive = d1 > 0 || d2 > 0 || d3 > 0;
+		return !(hasNegative && hasPositive);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected float GetTriangleDistanceSq(float px, float pz, float ax, float az, float bx, float bz, float cx, float cz)
+	{
+		if (IsPointInTriangle(px, pz, ax, az, bx, bz, cx, cz))
+			return 0;
+		
+		float distanceSq = GetSegmentDistanceSq(px, pz, ax, az, bx, bz);
+		distanceSq = Math.Min(distanceSq, GetSegmentDistanceSq(px, pz, bx, bz, cx, cz));
+		return Math.Min(distanceSq, GetSegmentDistanceSq(px, pz, cx, cz, ax, az));
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected float GetSegmentDistanceSq(float px, float pz, float ax, float az, float bx, float bz)
+	{
+		float ex = bx - ax;
+		float ez = bz - az;
+		float lengthSq = ex * ex + ez * ez;
+		
+		float t = 0;
+		if (lengthSq > 0)
+			t = Math.Clamp(((px - ax) * ex + (pz - az) * ez) / lengthSq, 0, 1);
+		
+		return GetDistanceSq(px, pz, ax + t * ex, az + t * ez);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected float GetDistanceSq(float ax, float az, float bx, float bz)
+	{
+		float dx = bx - ax;
+		float dz = bz - az;
+		return dx * dx + dz * dz;
+	}
+}
\ No newline at end of file
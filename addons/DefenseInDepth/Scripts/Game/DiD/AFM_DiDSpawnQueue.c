@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------------------------
+//! Single queued group spawn
+//------------------------------------------------------------------------------------------------
+class AFM_DiDSpawnRequest
+{
+	AFM_DiDSpawnerComponent m_Spawner;
+	int m_iPriority;
+	bool m_bCancelled;
+}
+
+//------------------------------------------------------------------------------------------------
+//! Spawn requests of all DiD spawners, drained by the zone system under a per-frame budget
+//! so a whole wave is not spawned in a single frame
+//! Requests are ordered by priority (higher first), FIFO within the same priority
+//------------------------------------------------------------------------------------------------
+class AFM_DiDSpawnQueue
+{
+	protected ref array<ref AFM_DiDSpawnRequest> m_aRequests = {};
+	
+	//------------------------------------------------------------------------------------------------
+	AFM_DiDSpawnRequest Enqueue(AFM_DiDSpawnerComponent spawner, int priority)
+	{
+		AFM_DiDSpawnRequest request = new AFM_DiDSpawnRequest();
+		request.m_Spawner = spawner;
+		request.m_iPriority = priority;
+		
+		int index = m_aRequests.Count();
+		while (index > 0 && m_aRequests[index - 1].m_iPriority < priority)
+		{
+			index--;
+		}
+		
+		m_aRequests.InsertAt(request, index);
+		return request;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Execute queued requests until maxRequests were spawned or budgetMs elapsed (0 = no time limit)
+	//! Returns number of executed requests
+	//------------------------------------------------------------------------------------------------
+	int Process(int maxRequests, int budgetMs)
+	{
+		int executed = 0;
+		int startTick = System.GetTickCount();
+		
+		while (executed < maxRequests && !m_aRequests.IsEmpty())
+		{
+			AFM_DiDSpawnRequest request = m_aRequests[0];
+			m_aRequests.RemoveOrdered(0);
+			
+			if (request.m_bCancelled || !request.m_Spawner)
+				continue;
+			
+			request.m_Spawner.ExecuteSpawnRequest(request);
+			executed++;
+			
+			if (budgetMs > 0 && System.GetTickCount() - startTick >= budgetMs)
+				break;
+		}
+		
+		return executed;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Cancel all pending requests of spawner, e.g. when its zone is deactivated
+	//------------------------------------------------------------------------------------------------
+	void CancelSpawner(AFM_DiDSpawnerComponent spawner)
+	{
+		for (int i = m_aRequests.Count() - 1; i >= 0; i--)
+		{
+			if (m_aRequests[i].m_Spawner == spawner)
+			{
+				m_aRequests[i].m_bCancelled = true;
+				m_aRequests.RemoveOrdered(i);
+			}
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int Count()
+	{
+		return m_aRequests.Count();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void Clear()
+	{
+		foreach (AFM_DiDSpawnRequest request : m_aRequests)
+		{
+			request.m_bCancelled = true;
+		}
+		m_aRequests.Clear();
+	}
+}
@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------------------------
+enum EAFMMortarSampler
+{
+	RANDOM,		// Independent uniform samples
+	HALTON,		// Randomly shifted Halton sequence, bases 2, 3, 5
+	STRATIFIED	// One jittered sample per equal area slice of the domain
+}
+
+//------------------------------------------------------------------------------------------------
+//! Sample point sets for mortar targeting
+//! Low discrepancy sets cover the domain evenly, so fewer samples find the same clusters
+//------------------------------------------------------------------------------------------------
+class AFM_DiDTargetSampler
+{
+	// Golden angle in radians, spreads disk points of the refinement spiral evenly
+	protected static const float GOLDEN_ANGLE = 2.39996323;
+	
+	//------------------------------------------------------------------------------------------------
+	//! Fill outSamples with count points inside domain, Y is left at 0
+	//------------------------------------------------------------------------------------------------
+	static void Generate(EAFMMortarSampler sampler, notnull AFM_DiDSamplingDomain domain, int count, notnull RandomGenerator random, notnull array<vector> outSamples)
+	{
+		outSamples.Clear();
+		if (domain.IsEmpty() || count <= 0)
+			return;
+		
+		switch (sampler)
+		{
+			case EAFMMortarSampler.HALTON:
+			{
+				// Random shift keeps successive updates from testing the same points
+				float shiftA = random.RandFloat01();
+				float shiftB = random.RandFloat01();
+				float shiftC = random.RandFloat01();
+				for (int i = 1; i <= count; i++)
+				{
+					float a = Wrap(RadicalInverse(i, 2) + shiftA);
+					float b = Wrap(RadicalInverse(i, 3) + shiftB);
+					float c = Wrap(RadicalInverse(i, 5) + shiftC);
+					outSamples.Insert(domain.MapPoint(a, b, c));
+				}
+				break;
+			}
+			case EAFMMortarSampler.STRATIFIED:
+			{
+				for (int i = 0; i < count; i++)
+				{
+					float selector = (i + random.RandFloat01()) / count;
+					outSamples.Insert(domain.MapPoint(selector, random.RandFloat01(), random.RandFloat01()));
+				}
+				break;
+			}
+			default:
+			{
+				for (int i = 0; i < count; i++)
+				{
+					outSamples.Insert(domain.Sample(random));
+				}
+				break;
+			}
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Fill outSamples with count points spread evenly over a disk, Y is left at 0
+	//------------------------------------------------------------------------------------------------
+	static void GenerateDisk(vector center, float radius, int count, notnull array<vector> outSamples)
+	{
+		outSamples.Clear();
+		for (int i = 0; i < count; i++)
+		{
+			float distance = radius * Math.Sqrt((i + 0.5) / count);
+			float angle = i * GOLDEN_ANGLE;
+			outSamples.Insert(Vector(center[0] + distance * Math.Cos(angle), 0, center[2] + distance * Math.Sin(angle)));
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Van der Corput radical inverse of index in given base
+	//------------------------------------------------------------------------------------------------
+	static float RadicalInverse(int index, int base)
+	{
+		float result = 0;
+		float fraction = 1.0 / base;
+		while (index > 0)
+		{
+			result += (index % base) * fraction;
+			index /= base;
+			fraction /= base;
+		}
+		return result;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static float Wrap(float value)
+	{
+		if (value >= 1)
+			return value - 1;
+		return value;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------------------------
+//! Scheduled wave of a single spawner
+//------------------------------------------------------------------------------------------------
+class AFM_DiDWaveTimer
+{
+	AFM_DiDSpawnerComponent m_Spawner;
+	WorldTimestamp m_fDueTime;
+}
+
+//------------------------------------------------------------------------------------------------
+//! Absolute-time wave timers of all DiD spawners, checked by the zone system every frame
+//! Timers are ordered by due time so idle spawners cost a single comparison per frame
+//------------------------------------------------------------------------------------------------
+class AFM_DiDWaveScheduler
+{
+	protected ref array<ref AFM_DiDWaveTimer> m_aTimers = {};
+	
+	//------------------------------------------------------------------------------------------------
+	//! Schedule next wave of spawner, replaces its pending timer
+	//------------------------------------------------------------------------------------------------
+	void Schedule(AFM_DiDSpawnerComponent spawner, WorldTimestamp dueTime)
+	{
+		Cancel(spawner);
+		
+		AFM_DiDWaveTimer timer = new AFM_DiDWaveTimer();
+		timer.m_Spawner = spawner;
+		timer.m_fDueTime = dueTime;
+		
+		int index = m_aTimers.Count();
+		while (index > 0 && m_aTimers[index - 1].m_fDueTime.Greater(dueTime))
+		{
+			index--;
+		}
+		
+		m_aTimers.InsertAt(timer, index);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void Cancel(AFM_DiDSpawnerComponent spawner)
+	{
+		for (int i = m_aTimers.Count() - 1; i >= 0; i--)
+		{
+			if (m_aTimers[i].m_Spawner == spawner)
+				m_aTimers.RemoveOrdered(i);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Fire all timers due at now, returns number of fired timers
+	//------------------------------------------------------------------------------------------------
+	int Process(WorldTimestamp now)
+	{
+		int fired = 0;
+		while (!m_aTimers.IsEmpty() && m_aTimers[0].m_fDueTime.LessEqual(now))
+		{
+			AFM_DiDSpawnerComponent spawner = m_aTimers[0].m_Spawner;
+			m_aTimers.RemoveOrdered(0);
+			
+			// Spawner usually schedules its next wave from here
+			if (spawner)
+				spawner.OnWaveTimer();
+			fired++;
+		}
+		
+		return fired;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int Count()
+	{
+		return m_aTimers.Count();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void Clear()
+	{
+		m_aTimers.Clear();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+//------------------------------------------------------------------------------------------------
+//! Snapshot of attackers and defenders of a zone, retaken in Process on every zone check, which
+//! the zone system schedules at an adaptive interval (see AFM_DiDZoneSystem.ComputeCheckInterval)
+//! Shared by the zone state machine, spawners, mortar targeting and replication so all of them
+//! see the same values between two checks
+//------------------------------------------------------------------------------------------------
+class AFM_DiDZoneCensus
+{
+	int m_iAttackersInside;
+	int m_iAttackersTotal;
+	int m_iDefendersAlive;
+	ref array<vector> m_aDefenderPositions = {};
+	WorldTimestamp m_fTimestamp;
+	
+	//------------------------------------------------------------------------------------------------
+	void Reset()
+	{
+		m_iAttackersInside = 0;
+		m_iAttackersTotal = 0;
+		m_iDefendersAlive = 0;
+		m_aDefenderPositions.Clear();
+	}
+}
@@ -32,10 +32,18 @@ class AFM_DiDZoneComponent: ScriptComponent
 	[Attribute("600", UIWidgets.EditBox, "Time in seconds to defend zone", category: "DiD")]
 	protected int m_iDefenseTimeSeconds;
 	
-	[Attribute("50", UIWidgets.EditBox, "Max number of AI groups", category: "DiD")]
+	[Attribute("250", UIWidgets.EditBox, "Max number of AI agents alive in the zone, split across its spawners by budget weight", category: "DiD")]
 	protected int m_iMaxAICount;
 	
+	[Attribute("2", UIWidgets.EditBox, "Cell size in meters of the occupancy grid used for presence checks (0 = exact polygon test only)", category: "DiD")]
+	protected float m_fOccupancyCellSize;
+	
+	[Attribute("0", UIWidgets.EditBox, "Cell size in meters of the cached terrain height field used by per sample height queries (0 = query the world every time). The field is sampled in a single frame, only worth it for large zones with many debug samples", category: "DiD")]
+	protected float m_fHeightFieldCellSize;
+	
 	protected PolylineShapeEntity m_PolylineEntity;
+	protected ref AFM_DiDZoneGeometry m_Geometry = new AFM_DiDZoneGeometry();
+	protected ref AFM_DiDHeightField m_HeightField = new AFM_DiDHeightField();
 	protected AFM_PlayerSpawnPointEntity m_PlayerSpawnPoint;
 	protected ref array<AFM_DiDSpawnerComponent> m_aSpawners = {};
 		
@@ -44,6 +52,16 @@ class AFM_DiDZoneComponent: ScriptComponent
 	protected WorldTimestamp m_fZoneStartTime;
 	protected WorldTimestamp m_fZoneEndTime;
 	protected int m_iRemainingTimeSeconds;
+	protected ref AFM_DiDZoneCensus m_Census = new AFM_DiDZoneCensus();
+	protected bool m_bPrewarmed;
+	
+	// Sum of spawner active AI counts
+	protected int m_iActiveAICount;
+	
+	// Hierarchy readiness polling
+	protected static const int INIT_RETRY_DELAY_MS = 100;
+	protected static const int MAX_INIT_ATTEMPTS = 100;
+	protected int m_iInitAttempts;
 	
 	// Faction configuration
 	protected SCR_Faction m_RedforFaction;
@@ -58,15 +76,56 @@ class AFM_DiDZoneComponent: ScriptComponent
 			return;
 		
 		//Only initialize when zone system is available (on authority)
-		if (AFM_DiDZoneSystem.GetInstance())
-			GetGame().GetCallqueue().CallLater(LateInit, 5000);
+		AFM_DiDZoneSystem zoneSystem = AFM_DiDZoneSystem.GetInstance();
+		if (!zoneSystem)
+			return;
+		
+		// Let the system know a zone is coming, it waits for registration before starting
+		zoneSystem.AnnounceZone(this);
+		GetGame().GetCallqueue().Call(LateInit);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Children, game mode and factions may still be initializing right after post init
+	//------------------------------------------------------------------------------------------------
+	protected bool IsReadyForInit()
+	{
+		if (!GetGame().GetGameMode() || !GetGame().GetFactionManager())
+			return false;
+		
+		IEntity e = GetOwner().GetChildren();
+		bool hasPolyline;
+		bool hasPlayerSpawnPoint;
+		while (e)
+		{
+			if (PolylineShapeEntity.Cast(e))
+				hasPolyline = true;
+			else if (AFM_PlayerSpawnPointEntity.Cast(e))
+				hasPlayerSpawnPoint = true;
+			e = e.GetSibling();
+		}
+		return hasPolyline && hasPlayerSpawnPoint;
 	}
 	
 	protected void LateInit()
 	{
+		// Retry until zone hierarchy and game mode are ready, give up after a while and report what is missing
+		if (!IsReadyForInit() && m_iInitAttempts < MAX_INIT_ATTEMPTS)
+		{
+			m_iInitAttempts++;
+			GetGame().GetCallqueue().CallLater(LateInit, INIT_RETRY_DELAY_MS);
+			return;
+		}
+		
+		// Hierarchy problems are reported below, the global preconditions only here
+		if (!GetGame().GetGameMode())
+			AFM_DiDLog.Write(EAFMDiDLogCategory.ZONE, LogLevel.ERROR, string.Format("AFM_DiDZoneComponent %1: Game mode not found after %2 attempts!", m_sZoneName, m_iInitAttempts));
+		if (!GetGame().GetFactionManager())
+			AFM_DiDLog.Write(EAFMDiDLogCategory.ZONE, LogLevel.ERROR, string.Format("AFM_DiDZoneComponent %1: Faction manager not found after %2 attempts!", m_sZoneName, m_iInitAttempts));
+		
 		IEntity e = GetOwner().GetChildren();
 		if (!e)
-			PrintFormat("AFM_DiDZoneComponent %1: No children found!", m_sZoneName, level: LogLevel.ERROR);
+			AFM_DiDLog.Write(EAFMDiDLogCategory.ZONE, LogLevel.ERROR, string.Format("AFM_DiDZoneComponent %1: No children found!", m_sZoneName));
 		
 		while (e)
 		{
@@ -91,9 +150,11 @@ class AFM_DiDZoneComponent: ScriptComponent
 		}
 		
 		if (!m_PolylineEntity)
-			PrintFormat("AFM_DiDZoneComponent %1: Missing polyline component, zone wont work properly!", m_sZoneName, level:LogLevel.ERROR);
+			AFM_DiDLog.Write(EAFMDiDLogCategory.ZONE, LogLevel.ERROR, string.Format("AFM_DiDZoneComponent %1: Missing polyline component, zone wont work properly!", m_sZoneName));
+		else if (!m_Geometry.Bake(m_PolylineEntity))
+			AFM_DiDLog.Write(EAFMDiDLogCategory.ZONE, LogLevel.ERROR, string.Format("AFM_DiDZoneComponent %1: Zone polyline needs at least 3 points!", m_sZoneName));
 		if (!m_PlayerSpawnPoint)
-			PrintFormat("AFM_DiDZoneComponent %1: Missing player spawnpoint, zone wont work properly!", m_sZoneName, level:LogLevel.ERROR);
+			AFM_DiDLog.Write(EAFMDiDLogCategory.ZONE, LogLevel.ERROR, string.Format("AFM_DiDZoneComponent %1: Missing player spawnpoint, zone wont work properly!", m_sZoneName));
 		if (m_aSpawners.Count() == 0)
 			PrintFormat("AFM_DiDZoneComponent %1: No spawner components found, AI will not spawn!", m_sZoneName, level:LogLevel.WARNING);
 		
@@ -103,96 +164,105 @@ class AFM_DiDZoneComponent: ScriptComponent
 			spawner.Prepare(this);
 		}
 		
-		if (!AFM_DiDZoneSystem.GetInstance().RegisterZone(this))
-			PrintFormat("AFM_DiDZoneComponent %1: Failed to register zone!", m_sZoneName, LogLevel.ERROR);
+		AFM_DiDZoneSystem zoneSystem = AFM_DiDZoneSystem.GetInstance();
+		if (!zoneSystem.RegisterZone(this))
+			AFM_DiDLog.Write(EAFMDiDLogCategory.ZONE, LogLevel.ERROR, string.Format("AFM_DiDZoneComponent %1: Failed to register zone!", m_sZoneName));
 		else
 			PrintFormat("AFM_DiDZoneComponent %1: Zone registered", m_sZoneName);
 		
 		
 		AFM_GameModeDiD gamemode = AFM_GameModeDiD.Cast(GetGame().GetGameMode());
 		if (!gamemode)
+			AFM_DiDLog.Write(EAFMDiDLogCategory.ZONE, LogLevel.ERROR, string.Format("AFM_DiDZoneComponent %1: Invalid gamemode!", m_sZoneName));
+		else
 		{
-			PrintFormat("AFM_DiDZoneComponent %1: Invalid gamemode!", m_sZoneName, level: LogLevel.ERROR);
-			return;
+			m_RedforFaction = gamemode.GetRedforFaction();
+			m_BluforFaction = gamemode.GetBluforFaction();
 		}
-		m_RedforFaction = gamemode.GetRedforFaction();
-		m_BluforFaction = gamemode.GetBluforFaction();
+		
+		// Factions must be set before the zone system may activate this zone
+		zoneSystem.OnZoneReady(this);
 	}
 	
 	//------------------------------------------------------------------------------------------------
-	int GetDefenderCount()
+	//! Refresh census snapshot, called from Process on every zone check and on entering PREPARE
+	//------------------------------------------------------------------------------------------------
+	void TakeCensus()
 	{
-		if (!m_BluforFaction)
-			return -1;
+		AFM_DiDProfiler profiler = AFM_DiDZoneSystem.GetInstance().GetProfiler();
+		int profileStart = profiler.Begin();
 		
-		array<int> playerIds = new array<int>;
-		m_BluforFaction.GetPlayersInFaction(playerIds);
-		int remainingPlayers = 0;
+		m_Census.Reset();
+		m_Census.m_fTimestamp = GetCurrentTimestamp();
+		CountDefenders(m_Census);
+		CountAttackers(m_Census);
 		
-		foreach(int id: playerIds)
+		profiler.End("zone.census", profileStart);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void CountDefenders(AFM_DiDZoneCensus census)
+	{
+		if (!m_BluforFaction)
 		{
-			PlayerController pc = GetGame().GetPlayerManager().GetPlayerController(id);
-			if (pc)
-			{
-				SCR_ChimeraCharacter ent = SCR_ChimeraCharacter.Cast(pc.GetControlledEntity());		
-				if (!ent)
-					continue;
-				SCR_DamageManagerComponent damageManager = ent.GetDamageManager();
-				if (damageManager && !damageManager.IsDestroyed())
-					remainingPlayers++;
-			}
+			census.m_iDefendersAlive = -1;
+			return;
 		}
 		
-		return remainingPlayers;
+		AFM_DiDDefenderTracker tracker = AFM_DiDZoneSystem.GetInstance().GetDefenderTracker();
+		tracker.CollectPositions(census.m_aDefenderPositions);
+		census.m_iDefendersAlive = tracker.GetCount();
 	}
 	
-	int GetAICountInsideZone()
+	//------------------------------------------------------------------------------------------------
+	protected void CountAttackers(AFM_DiDZoneCensus census)
 	{
-		WorldTimestamp timeStart = GetCurrentTimestamp();
-	
-		if (!m_PolylineEntity)
-			return -1;
-		
-		vector zonePos = m_PolylineEntity.GetOrigin();
-		
-		array<vector> zonePolylinePoints3d = {};
-		m_PolylineEntity.GetPointsPositions(zonePolylinePoints3d);
-		
-		array<float> zonePolylinePoints2d = {};
-		foreach(vector p: zonePolylinePoints3d)
+		if (!m_Geometry.IsValid())
 		{
-			zonePolylinePoints2d.Insert(p[0] + zonePos[0]);
-			zonePolylinePoints2d.Insert(p[2] + zonePos[2]);
+			census.m_iAttackersInside = -1;
+			return;
 		}
 		
-		array<AIAgent> agents = {};
-		GetGame().GetAIWorld().GetAIAgents(agents);
+		// Use result of the incremental census when it already swept this zone
+		AFM_DiDZoneSystem zoneSystem = AFM_DiDZoneSystem.GetInstance();
+		if (zoneSystem.IsIncrementalCensusEnabled() && zoneSystem.GetAttackerSweep().GetResult(this, census))
+			return;
 		
-		int count = 0;
-		int totalAgentCount = 0;
+		AFM_DiDAttackerRegistry registry = zoneSystem.GetAttackerRegistry();
 		
-		foreach(AIAgent agent: agents)
+		for (int i = registry.Count() - 1; i >= 0; i--)
 		{
-			if (!agent.IsInherited(SCR_ChimeraAIAgent) || !agent.IsInherited(ChimeraAIAgent))
-				continue;
-
-			IEntity agentEntity = agent.GetControlledEntity();
-			if (!agentEntity)
-				continue;
-			
-			SCR_ChimeraCharacter character = SCR_ChimeraCharacter.Cast(agentEntity);
-			if (!character || character.GetFactionKey() != m_RedforFaction.GetFactionKey())
+			AFM_DiDAttackerEntry entry = registry.Get(i);
+			if (!entry.IsAlive())
+			{
+				// Drop deleted agents and dead characters, keep agents still waiting for their entity
+				if (!entry.m_Agent || entry.GetCharacter())
+					registry.RemoveAt(i);
 				continue;
+			}
 			
-			vector pos = character.GetOrigin();
-			if (Math2D.IsPointInPolygon(zonePolylinePoints2d, pos[0], pos[2]))
-				count++;
-			totalAgentCount++;
+			if (entry.IsInside(m_Geometry))
+				census.m_iAttackersInside++;
+			census.m_iAttackersTotal++;
 		}
-		
-		WorldTimestamp end = GetCurrentTimestamp();
-		PrintFormat("AFM_DiDZoneComponent %1: Found %2/%3 AIs inside zone. Took %4ms", m_sZoneName, count, totalAgentCount, end.DiffMilliseconds(timeStart).ToString(), level: LogLevel.DEBUG);
-		return count;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Census taken during the last zone check
+	//------------------------------------------------------------------------------------------------
+	AFM_DiDZoneCensus GetCensus()
+	{
+		return m_Census;
+	}
+	
+	int GetDefenderCount()
+	{
+		return m_Census.m_iDefendersAlive;
+	}
+	
+	int GetAICountInsideZone()
+	{
+		return m_Census.m_iAttackersInside;
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -200,11 +270,16 @@ class AFM_DiDZoneComponent: ScriptComponent
 	//------------------------------------------------------------------------------------------------
 	protected void Cleanup()
 	{
+		AFM_DiDProfiler profiler = AFM_DiDZoneSystem.GetInstance().GetProfiler();
+		int profileStart = profiler.Begin();
+		
 		foreach (AFM_DiDSpawnerComponent spawner : m_aSpawners)
 		{
 			if (spawner)
 				spawner.Cleanup();
 		}
+		
+		profiler.End("zone.cleanup", profileStart);
 	}
 	
 	protected void FinishZoneHeld()
@@ -254,6 +329,12 @@ class AFM_DiDZoneComponent: ScriptComponent
 			m_fZoneStartTime = now;
 			m_fZoneEndTime = now.PlusSeconds(m_iDefenseTimeSeconds);
 			PrintFormat("AFM_DiDZoneComponent %1: PREPARE -> ACTIVE", m_sZoneName);	
+			
+			foreach (AFM_DiDSpawnerComponent spawner : m_aSpawners)
+			{
+				if (spawner)
+					spawner.StartWaves();
+			}
 		}
 		
 		return m_eZoneState;
@@ -261,8 +342,8 @@ class AFM_DiDZoneComponent: ScriptComponent
 	
 	protected EAFMZoneState HandleActiveZoneLogic()
 	{
-		int defenderCount = GetDefenderCount();
-		int attackerCount = GetAICountInsideZone();
+		int defenderCount = m_Census.m_iDefendersAlive;
+		int attackerCount = m_Census.m_iAttackersInside;
 		
 		if (defenderCount == 0)
 		{
@@ -290,10 +371,15 @@ class AFM_DiDZoneComponent: ScriptComponent
 		}
 		
 		// Delegate spawning to spawner components
+		AFM_DiDProfiler profiler = AFM_DiDZoneSystem.GetInstance().GetProfiler();
 		foreach (AFM_DiDSpawnerComponent spawner : m_aSpawners)
 		{
-			if (spawner)
-				spawner.Process();
+			if (!spawner)
+				continue;
+			
+			int profileStart = profiler.Begin();
+			spawner.Process(m_Census);
+			profiler.End(spawner.GetProfilerScope(), profileStart);
 		}
 		
 		return m_eZoneState;
@@ -305,6 +391,9 @@ class AFM_DiDZoneComponent: ScriptComponent
 	
 	EAFMZoneState Process()
 	{
+		if (!IsZoneFinished() && m_eZoneState != EAFMZoneState.INACTIVE)
+			TakeCensus();
+		
 		switch (m_eZoneState)
 		{
 			case EAFMZoneState.INACTIVE:
@@ -316,9 +405,13 @@ class AFM_DiDZoneComponent: ScriptComponent
 				return HandlePrepareLogic();
 			case EAFMZoneState.ACTIVE:
 			case EAFMZoneState.FROZEN:
-				return HandleActiveZoneLogic();
+				AFM_DiDProfiler profiler = AFM_DiDZoneSystem.GetInstance().GetProfiler();
+				int profileStart = profiler.Begin();
+				EAFMZoneState state = HandleActiveZoneLogic();
+				profiler.End("zone.stateLogic", profileStart);
+				return state;
 			default:
-				PrintFormat("AFM_DiDZoneComponent %1: Unknown zone state %2", m_sZoneName, m_eZoneState, level:LogLevel.ERROR);
+				AFM_DiDLog.Write(EAFMDiDLogCategory.ZONE, LogLevel.ERROR, string.Format("AFM_DiDZoneComponent %1: Unknown zone state %2", m_sZoneName, m_eZoneState));
 				return m_eZoneState;
 		}
 		
@@ -353,14 +446,111 @@ class AFM_DiDZoneComponent: ScriptComponent
 		m_eZoneState = EAFMZoneState.PREPARE;
 		m_fZoneStartTime = now;
 		m_fZoneEndTime = now.PlusSeconds(m_iPrepareTimeSeconds);
+		
+		// Prewarmed zones already did the heavy lifting while the previous zone was fought
+		if (!m_bPrewarmed)
+		{
+			PreloadPrefabs();
+			BuildOccupancyGrid();
+			BuildHeightField();
+		}
+		m_bPrewarmed = false;
+		
+		TakeCensus();
 		PrintFormat("AFM_DiDZoneComponent %1: Entering PREPARE state for %2 seconds",
 		 m_sZoneName, m_iPrepareTimeSeconds);
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Prepare inactive zone ahead of its activation, called by the zone system while the
+	//! previous zone is active
+	//! @param stagingPool When set, first wave of each spawner is spawned disabled into this pool
+	//------------------------------------------------------------------------------------------------
+	void Prewarm(AFM_DiDGroupPool stagingPool)
+	{
+		if (m_eZoneState != EAFMZoneState.INACTIVE || m_bPrewarmed)
+			return;
+		
+		PreloadPrefabs();
+		BuildOccupancyGrid();
+		BuildHeightField();
+		
+		if (stagingPool)
+		{
+			foreach (AFM_DiDSpawnerComponent spawner : m_aSpawners)
+			{
+				if (spawner)
+					spawner.StageFirstWave(stagingPool);
+			}
+		}
+		
+		m_bPrewarmed = true;
+		if (AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.ZONE, LogLevel.DEBUG))
+			AFM_DiDLog.Write(EAFMDiDLogCategory.ZONE, LogLevel.DEBUG, string.Format("AFM_DiDZoneComponent %1: Prewarmed", m_sZoneName));
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool IsPrewarmed()
+	{
+		return m_bPrewarmed;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void BuildOccupancyGrid()
+	{
+		if (m_fOccupancyCellSize <= 0 || m_Geometry.IsRasterized())
+			return;
+		
+		if (!m_Geometry.Rasterize(m_fOccupancyCellSize))
+			PrintFormat("AFM_DiDZoneComponent %1: Occupancy grid not built, using exact polygon test", m_sZoneName, level:LogLevel.WARNING);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void BuildHeightField()
+	{
+		if (m_fHeightFieldCellSize <= 0 || m_HeightField.IsBuilt() || !m_Geometry.IsValid())
+			return;
+		
+		vector minBounds, maxBounds;
+		m_Geometry.GetBounds(minBounds, maxBounds);
+		
+		AFM_DiDProfiler profiler = AFM_DiDZoneSystem.GetInstance().GetProfiler();
+		int profileStart = profiler.Begin();
+		bool built = m_HeightField.Build(minBounds, maxBounds, m_fHeightFieldCellSize);
+		profiler.End("zone.heightField", profileStart);
+		
+		if (!built)
+			PrintFormat("AFM_DiDZoneComponent %1: Height field not built, using world height queries", m_sZoneName, level: LogLevel.WARNING);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Load prefabs of all spawners into the mission prefab cache
+	//------------------------------------------------------------------------------------------------
+	void PreloadPrefabs()
+	{
+		array<ResourceName> prefabs = {};
+		foreach (AFM_DiDSpawnerComponent spawner : m_aSpawners)
+		{
+			if (spawner)
+				spawner.CollectPrefabs(prefabs);
+		}
+		
+		AFM_DiDZoneSystem.GetInstance().GetPrefabCache().Preload(prefabs);
+	}
+	
 	void DeactivateZone()
 	{
 		m_eZoneState = EAFMZoneState.INACTIVE;
 		Cleanup();
+		
+		// Staged groups the first wave did not pick up would otherwise stay reserved for good
+		AFM_DiDGroupPool pool = AFM_DiDZoneSystem.GetInstance().GetGroupPool();
+		if (pool)
+			pool.ReleaseZone(m_iZoneIndex);
+		
+		m_Geometry.ReleaseRaster();
+		m_HeightField.Release();
+		m_bPrewarmed = false;
 		PrintFormat("AFM_DiDZoneComponent %1: Deactivated", m_sZoneName);
 	}
 	
@@ -393,6 +583,41 @@ class AFM_DiDZoneComponent: ScriptComponent
 		return m_PolylineEntity;
 	}
 	
+	AFM_DiDZoneGeometry GetGeometry()
+	{
+		return m_Geometry;
+	}
+	
+	void GetSpawners(notnull array<AFM_DiDSpawnerComponent> outSpawners)
+	{
+		outSpawners.Copy(m_aSpawners);
+	}
+	
+	bool IsPointInZone(vector pos)
+	{
+		return m_Geometry.IsPointInside(pos);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Terrain height from the zone height field, falls back to the world query outside of it
+	//! Meant for per sample queries, use the world query for final placement
+	//------------------------------------------------------------------------------------------------
+	float GetSurfaceY(float x, float z)
+	{
+		if (m_HeightField.IsInBounds(x, z))
+			return m_HeightField.GetHeight(x, z);
+		
+		return GetGame().GetWorld().GetSurfaceY(x, z);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Does the zone timer freeze when attackers outnumber defenders
+	//------------------------------------------------------------------------------------------------
+	bool IsFreezeEnabled()
+	{
+		return m_bStopTimerOnRedforSuperiority;
+	}
+	
 	SCR_Faction GetDefenderFaction()
 	{
 		return m_BluforFaction;
@@ -408,13 +633,15 @@ class AFM_DiDZoneComponent: ScriptComponent
 	//------------------------------------------------------------------------------------------------
 	int GetActiveAICount()
 	{
-		int totalCount = 0;
-		foreach (AFM_DiDSpawnerComponent spawner : m_aSpawners)
-		{
-			if (spawner)
-				totalCount += spawner.GetActiveAICount();
-		}
-		return totalCount;
+		return m_iActiveAICount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Called by spawners whenever their active AI count changes
+	//------------------------------------------------------------------------------------------------
+	void OnActiveAICountChanged(int delta)
+	{
+		m_iActiveAICount = Math.Max(0, m_iActiveAICount + delta);
 	}
 	
 	protected bool IsZoneTimeExpired()
@@ -435,4 +662,36 @@ class AFM_DiDZoneComponent: ScriptComponent
 	{
 		return m_iMaxAICount;
 	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Max AI agents of the zone, zone limit capped by the zone system AI governor
+	//------------------------------------------------------------------------------------------------
+	int GetAIBudget()
+	{
+		int budget = GetZoneAILimit();
+		int globalBudget = AFM_DiDZoneSystem.GetInstance().GetAIBudget();
+		if (globalBudget >= 0)
+			budget = Math.Min(budget, globalBudget);
+		
+		return budget;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Share of the zone AI budget for given spawner, weighted by spawner budget weights
+	//------------------------------------------------------------------------------------------------
+	int GetSpawnerAIBudget(AFM_DiDSpawnerComponent spawner)
+	{
+		float totalWeight = 0;
+		foreach (AFM_DiDSpawnerComponent zoneSpawner : m_aSpawners)
+		{
+			if (zoneSpawner)
+				totalWeight += zoneSpawner.GetAIBudgetWeight();
+		}
+		
+		int budget = GetAIBudget();
+		if (totalWeight <= 0)
+			return budget;
+		
+		return Math.Ceil(budget * spawner.GetAIBudgetWeight() / totalWeight);
+	}
 }
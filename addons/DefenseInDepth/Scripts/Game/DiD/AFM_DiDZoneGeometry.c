@@ -0,0 +1,403 @@
+//------------------------------------------------------------------------------------------------
+//! Zone polygon baked once from the zone PolylineShapeEntity
+//! Keeps world space 2D vertices, bounding box, edge slopes and area so presence checks
+//! don't have to query the polyline again
+//! Optionally rasterized into an occupancy grid, only cells crossed by the outline fall back
+//! to the exact polygon test
+//------------------------------------------------------------------------------------------------
+class AFM_DiDZoneGeometry
+{
+	// Flat world space buffer [x0, z0, x1, z1, ...] in the layout expected by Math2D
+	protected ref array<float> m_aPoints2D = {};
+
+	// dx/dz of every edge i -> i+1 (edges parallel to X axis store 0)
+	protected ref array<float> m_aEdgeSlopes = {};
+
+	protected float m_fMinX;
+	protected float m_fMinZ;
+	protected float m_fMaxX;
+	protected float m_fMaxZ;
+	protected float m_fArea;
+
+	// Occupancy grid, cell index = row * width + col, 32 cells per int
+	protected const int MAX_GRID_CELLS = 1048576;
+	protected float m_fCellSize;
+	protected int m_iGridWidth;
+	protected int m_iGridHeight;
+	protected ref array<int> m_aInsideBits;
+	protected ref array<int> m_aBoundaryBits;
+
+	//------------------------------------------------------------------------------------------------
+	//! Bake polygon from polyline points, returns false when polyline does not form a polygon
+	//------------------------------------------------------------------------------------------------
+	bool Bake(PolylineShapeEntity polyline)
+	{
+		m_aPoints2D.Clear();
+		m_aEdgeSlopes.Clear();
+		m_fArea = 0;
+
+		if (!polyline)
+			return false;
+
+		array<vector> points = {};
+		polyline.GetPointsPositions(points);
+		if (points.Count() < 3)
+			return false;
+
+		vector origin = polyline.GetOrigin();
+		vector first = points[0];
+		m_fMinX = origin[0] + first[0];
+		m_fMaxX = m_fMinX;
+		m_fMinZ = origin[2] + first[2];
+		m_fMaxZ = m_fMinZ;
+
+		foreach (vector p : points)
+		{
+			float x = origin[0] + p[0];
+			float z = origin[2] + p[2];
+			m_aPoints2D.Insert(x);
+			m_aPoints2D.Insert(z);
+
+			m_fMinX = Math.Min(m_fMinX, x);
+			m_fMaxX = Math.Max(m_fMaxX, x);
+			m_fMinZ = Math.Min(m_fMinZ, z);
+			m_fMaxZ = Math.Max(m_fMaxZ, z);
+		}
+
+		int count = GetVertexCount();
+		for (int i = 0; i < count; i++)
+		{
+			int j = (i + 1) % count;
+			float x1 = m_aPoints2D[i * 2];
+			float z1 = m_aPoints2D[i * 2 + 1];
+			float x2 = m_aPoints2D[j * 2];
+			float z2 = m_aPoints2D[j * 2 + 1];
+
+			float dz = z2 - z1;
+			if (dz == 0)
+				m_aEdgeSlopes.Insert(0);
+			else
+				m_aEdgeSlopes.Insert((x2 - x1) / dz);
+
+			// Shoelace formula
+			m_fArea += x1 * z2 - x2 * z1;
+		}
+		m_fArea = Math.AbsFloat(m_fArea) * 0.5;
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool IsValid()
+	{
+		return m_aPoints2D.Count() >= 6;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Point in polygon test with bounding box rejection, only X and Z of the point are used
+	//------------------------------------------------------------------------------------------------
+	bool IsPointInside(vector pos)
+	{
+		return IsPointInside2D(pos[0], pos[2]);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool IsPointInside2D(float x, float z)
+	{
+		if (!IsInBounds(x, z))
+			return false;
+
+		if (m_aInsideBits)
+		{
+			int cell = GetCellIndex(x, z);
+			if (!TestBit(m_aBoundaryBits, cell))
+				return TestBit(m_aInsideBits, cell);
+		}
+
+		return Math2D.IsPointInPolygon(m_aPoints2D, x, z);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Point in polygon test that also returns clearance, the distance the point can move without
+	//! its inside/outside state changing
+	//! Clearance is conservative: distance to bounding box when outside of it, distance to cell
+	//! border for interior/exterior grid cells and distance to nearest edge for exact tests
+	//------------------------------------------------------------------------------------------------
+	bool IsPointInsideWithClearance(float x, float z, out float clearance)
+	{
+		if (!IsInBounds(x, z))
+		{
+			float outX = Math.Max(0, Math.Max(m_fMinX - x, x - m_fMaxX));
+			float outZ = Math.Max(0, Math.Max(m_fMinZ - z, z - m_fMaxZ));
+			clearance = Math.Sqrt(outX * outX + outZ * outZ);
+			return false;
+		}
+
+		if (m_aInsideBits)
+		{
+			int cell = GetCellIndex(x, z);
+			if (!TestBit(m_aBoundaryBits, cell))
+			{
+				float cellX = (x - m_fMinX) / m_fCellSize;
+				float cellZ = (z - m_fMinZ) / m_fCellSize;
+				float fracX = cellX - Math.Floor(cellX);
+				float fracZ = cellZ - Math.Floor(cellZ);
+				clearance = Math.Min(Math.Min(fracX, 1 - fracX), Math.Min(fracZ, 1 - fracZ)) * m_fCellSize;
+				return TestBit(m_aInsideBits, cell);
+			}
+		}
+
+		clearance = GetDistanceToBoundary(x, z);
+		return Math2D.IsPointInPolygon(m_aPoints2D, x, z);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Distance from point to the nearest polygon edge
+	//------------------------------------------------------------------------------------------------
+	float GetDistanceToBoundary(float x, float z)
+	{
+		float minDistSq = float.MAX;
+		int count = GetVertexCount();
+		for (int i = 0; i < count; i++)
+		{
+			int j = (i + 1) % count;
+			float x1 = m_aPoints2D[i * 2];
+			float z1 = m_aPoints2D[i * 2 + 1];
+			float ex = m_aPoints2D[j * 2] - x1;
+			float ez = m_aPoints2D[j * 2 + 1] - z1;
+
+			// Project point onto edge and clamp to its endpoints
+			float t = 0;
+			float lenSq = ex * ex + ez * ez;
+			if (lenSq > 0)
+				t = Math.Clamp(((x - x1) * ex + (z - z1) * ez) / lenSq, 0, 1);
+
+			float dx = x1 + t * ex - x;
+			float dz = z1 + t * ez - z;
+			minDistSq = Math.Min(minDistSq, dx * dx + dz * dz);
+		}
+
+		return Math.Sqrt(minDistSq);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Build occupancy grid with given cell size in meters
+	//! Returns false when grid is disabled (cellSize <= 0) or would be too large
+	//------------------------------------------------------------------------------------------------
+	bool Rasterize(float cellSize)
+	{
+		ReleaseRaster();
+		if (cellSize <= 0 || !IsValid())
+			return false;
+
+		int width = Math.Max(1, Math.Ceil((m_fMaxX - m_fMinX) / cellSize));
+		int height = Math.Max(1, Math.Ceil((m_fMaxZ - m_fMinZ) / cellSize));
+		if (width * height > MAX_GRID_CELLS)
+			return false;
+
+		m_fCellSize = cellSize;
+		m_iGridWidth = width;
+		m_iGridHeight = height;
+
+		int words = (width * height + 31) / 32;
+		m_aInsideBits = new array<int>();
+		m_aInsideBits.Resize(words);
+		m_aBoundaryBits = new array<int>();
+		m_aBoundaryBits.Resize(words);
+		for (int w = 0; w < words; w++)
+		{
+			m_aInsideBits[w] = 0;
+			m_aBoundaryBits[w] = 0;
+		}
+
+		RasterizeInterior();
+
+		int count = GetVertexCount();
+		for (int i = 0; i < count; i++)
+		{
+			int j = (i + 1) % count;
+			MarkBoundary(m_aPoints2D[i * 2], m_aPoints2D[i * 2 + 1], m_aPoints2D[j * 2], m_aPoints2D[j * 2 + 1]);
+		}
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void ReleaseRaster()
+	{
+		m_aInsideBits = null;
+		m_aBoundaryBits = null;
+		m_iGridWidth = 0;
+		m_iGridHeight = 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool IsRasterized()
+	{
+		return m_aInsideBits != null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Scanline fill through cell centers, crossings are computed from cached edge slopes
+	//------------------------------------------------------------------------------------------------
+	protected void RasterizeInterior()
+	{
+		int count = GetVertexCount();
+		array<float> crossings = {};
+
+		for (int row = 0; row < m_iGridHeight; row++)
+		{
+			float z = m_fMinZ + (row + 0.5) * m_fCellSize;
+			crossings.Clear();
+
+			for (int i = 0; i < count; i++)
+			{
+				int j = (i + 1) % count;
+				float z1 = m_aPoints2D[i * 2 + 1];
+				float z2 = m_aPoints2D[j * 2 + 1];
+				if ((z1 <= z) == (z2 <= z))
+					continue;
+
+				crossings.Insert(m_aPoints2D[i * 2] + (z - z1) * m_aEdgeSlopes[i]);
+			}
+
+			crossings.Sort();
+
+			for (int k = 0; k + 1 < crossings.Count(); k += 2)
+			{
+				int colStart = Math.Max(0, Math.Ceil((crossings[k] - m_fMinX) / m_fCellSize - 0.5));
+				int colEnd = Math.Min(m_iGridWidth - 1, Math.Floor((crossings[k + 1] - m_fMinX) / m_fCellSize - 0.5));
+				for (int col = colStart; col <= colEnd; col++)
+				{
+					SetBit(m_aInsideBits, row * m_iGridWidth + col);
+				}
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Mark every cell crossed by the edge as boundary (grid traversal by Amanatides & Woo)
+	//------------------------------------------------------------------------------------------------
+	protected void MarkBoundary(float x1, float z1, float x2, float z2)
+	{
+		float fx = (x1 - m_fMinX) / m_fCellSize;
+		float fz = (z1 - m_fMinZ) / m_fCellSize;
+		float dx = (x2 - m_fMinX) / m_fCellSize - fx;
+		float dz = (z2 - m_fMinZ) / m_fCellSize - fz;
+
+		int col = Math.ClampInt(Math.Floor(fx), 0, m_iGridWidth - 1);
+		int row = Math.ClampInt(Math.Floor(fz), 0, m_iGridHeight - 1);
+		int endCol = Math.ClampInt(Math.Floor(fx + dx), 0, m_iGridWidth - 1);
+		int endRow = Math.ClampInt(Math.Floor(fz + dz), 0, m_iGridHeight - 1);
+
+		int stepX = 1;
+		if (dx < 0)
+			stepX = -1;
+		int stepZ = 1;
+		if (dz < 0)
+			stepZ = -1;
+
+		// Parametric distance along the edge to the next column/row border
+		float tDeltaX = float.MAX;
+		float tMaxX = float.MAX;
+		if (dx != 0)
+		{
+			tDeltaX = Math.AbsFloat(1 / dx);
+			if (dx > 0)
+				tMaxX = (Math.Floor(fx) + 1 - fx) * tDeltaX;
+			else
+				tMaxX = (fx - Math.Floor(fx)) * tDeltaX;
+		}
+
+		float tDeltaZ = float.MAX;
+		float tMaxZ = float.MAX;
+		if (dz != 0)
+		{
+			tDeltaZ = Math.AbsFloat(1 / dz);
+			if (dz > 0)
+				tMaxZ = (Math.Floor(fz) + 1 - fz) * tDeltaZ;
+			else
+				tMaxZ = (fz - Math.Floor(fz)) * tDeltaZ;
+		}
+
+		SetBit(m_aBoundaryBits, row * m_iGridWidth + col);
+
+		// Guard against endless walk when clamped end cell can't be reached
+		int steps = m_iGridWidth + m_iGridHeight;
+		while ((col != endCol || row != endRow) && steps > 0)
+		{
+			if (tMaxX < tMaxZ)
+			{
+				tMaxX += tDeltaX;
+				col = Math.ClampInt(col + stepX, 0, m_iGridWidth - 1);
+			}
+			else
+			{
+				tMaxZ += tDeltaZ;
+				row = Math.ClampInt(row + stepZ, 0, m_iGridHeight - 1);
+			}
+
+			SetBit(m_aBoundaryBits, row * m_iGridWidth + col);
+			steps--;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected int GetCellIndex(float x, float z)
+	{
+		int col = Math.ClampInt((x - m_fMinX) / m_fCellSize, 0, m_iGridWidth - 1);
+		int row = Math.ClampInt((z - m_fMinZ) / m_fCellSize, 0, m_iGridHeight - 1);
+		return row * m_iGridWidth + col;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void SetBit(array<int> bits, int index)
+	{
+		bits[index >> 5] = bits[index >> 5] | (1 << (index & 31));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool TestBit(array<int> bits, int index)
+	{
+		return (bits[index >> 5] & (1 << (index & 31))) != 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool IsInBounds(float x, float z)
+	{
+		return x >= m_fMinX && x <= m_fMaxX && z >= m_fMinZ && z <= m_fMaxZ;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetVertexCount()
+	{
+		return m_aPoints2D.Count() / 2;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	array<float> GetPoints2D()
+	{
+		return m_aPoints2D;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	array<float> GetEdgeSlopes()
+	{
+		return m_aEdgeSlopes;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Bounding box in world space, Y is left at 0
+	//------------------------------------------------------------------------------------------------
+	void GetBounds(out vector minBounds, out vector maxBounds)
+	{
+		minBounds = Vector(m_fMinX, 0, m_fMinZ);
+		maxBounds = Vector(m_fMaxX, 0, m_fMaxZ);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float GetArea()
+	{
+		return m_fArea;
+	}
+}
@@ -1,16 +1,144 @@
 class AFM_DiDZoneSystem: GameSystem
 {
+	[Attribute("0", UIWidgets.EditBox, "Attackers checked per frame by the incremental census, result is published once a full sweep completes (0 = count all attackers at once on the zone tick)")]
+	protected int m_iCensusAgentsPerFrame;
+	
+	[Attribute("1", UIWidgets.EditBox, "Max AI groups or vehicles spawned per frame from the spawn queue")]
+	protected int m_iSpawnsPerFrame;
+	
+	[Attribute("0", UIWidgets.EditBox, "Time budget in milliseconds for the spawn queue per frame (0 = limited by spawn count only)")]
+	protected int m_iSpawnBudgetMs;
+	
+	[Attribute("4", UIWidgets.EditBox, "Max entities deleted per frame when cleaning up a finished zone")]
+	protected int m_iDespawnsPerFrame;
+	
+	[Attribute("300", UIWidgets.EditBox, "Entities closer than this (meters) and in front of a defender are deleted later")]
+	protected float m_fDespawnVisibleDistance;
+	
+	[Attribute("30", UIWidgets.EditBox, "Max time in seconds an entity in view of a defender may be kept before it is deleted anyway")]
+	protected float m_fDespawnMaxDeferSeconds;
+	
+	[Attribute("0.5", UIWidgets.EditBox, "Shortest time in seconds between zone checks, used when the freeze or fail decision is close")]
+	protected float m_fMinCheckInterval;
+	
+	[Attribute("30", UIWidgets.EditBox, "Max time in seconds the zone system waits for all zones to get ready before starting")]
+	protected float m_fZoneReadyTimeout;
+	
+	[Attribute("60", UIWidgets.EditBox, "Seconds per profiler scope the timing stats are computed over")]
+	protected int m_iProfilerWindowSize;
+	
+	[Attribute("600", UIWidgets.EditBox, "Seconds between profiler stats written to the log (0 = only on #didprof)")]
+	protected float m_fProfilerLogInterval;
+	
+	[Attribute("3", UIWidgets.EditBox, "Longest time in seconds between zone checks while the zone is active")]
+	protected float m_fMaxCheckInterval;
+	
+	[Attribute("0", UIWidgets.CheckBox, "Park surviving AI groups of finished zones and reuse them for later waves of the same prefab")]
+	protected bool m_bEnableGroupPool;
+	
+	[Attribute("0 1000 0", UIWidgets.Coords, "World position where pooled groups are parked with AI and simulation disabled")]
+	protected vector m_vGroupPoolHoldingPosition;
+	
+	[Attribute("20", UIWidgets.EditBox, "Max parked AI groups, remaining survivors are deleted (0 = unlimited)")]
+	protected int m_iGroupPoolMaxGroups;
+	
+	[Attribute("1", UIWidgets.CheckBox, "Preload prefabs and build the occupancy grid of the next zone while the current zone is active")]
+	protected bool m_bPrewarmNextZone;
+	
+	[Attribute("0", UIWidgets.CheckBox, "Also spawn the first wave of the next zone disabled in the group pool holding area (requires group pool)")]
+	protected bool m_bStageNextZoneWave;
+	
+	[Attribute("1", UIWidgets.CheckBox, "Scale the attacker AI budget with server frame time")]
+	protected bool m_bEnableAIGovernor;
+	
+	[Attribute("30", UIWidgets.EditBox, "Server FPS the AI governor tries to keep")]
+	protected float m_fGovernorTargetFPS;
+	
+	[Attribute("20", UIWidgets.EditBox, "Lowest attacker AI budget the governor may set")]
+	protected int m_iGovernorMinAI;
+	
+	[Attribute("150", UIWidgets.EditBox, "Highest attacker AI budget the governor may set")]
+	protected int m_iGovernorMaxAI;
+	
+	[Attribute("4", UIWidgets.EditBox, "AI added to the budget per second while the server has headroom")]
+	protected int m_iGovernorIncreaseStep;
+	
+	[Attribute("1", UIWidgets.CheckBox, "Remove attacker corpses and destroyed vehicles spawned by DiD spawners")]
+	protected bool m_bEnableCollector;
+	
+	[Attribute("120", UIWidgets.EditBox, "Seconds after death an attacker corpse may be removed")]
+	protected float m_fCollectorCorpseAgeSeconds;
+	
+	[Attribute("300", UIWidgets.EditBox, "Seconds after destruction a vehicle wreck may be removed")]
+	protected float m_fCollectorWreckAgeSeconds;
+	
+	[Attribute("150", UIWidgets.EditBox, "Corpses and wrecks closer than this (meters) to a defender are kept past their age")]
+	protected float m_fCollectorMinDistance;
+	
+	[Attribute("40", UIWidgets.EditBox, "Max corpses and wrecks kept per zone, oldest are removed first (0 = unlimited)")]
+	protected int m_iCollectorMaxPerZone;
+	
+	[Attribute("1", UIWidgets.EditBox, "Max corpses and wrecks deleted per frame by the collector")]
+	protected int m_iCollectorDespawnsPerFrame;
+	
 	protected ref map<int, AFM_DiDZoneComponent> m_aZones = new map<int, AFM_DiDZoneComponent>();
 	protected AFM_DiDZoneComponent m_ActiveZone = null;
 	
 	
-	// How often should the system check zones (in seconds)
-	protected const float m_fCheckInterval = 1.0;
+	// Time until the next zone check (in seconds), adapted after every check
+	protected float m_fCheckInterval = 1.0;
 	protected float m_fCheckTimer = 0;
 	
+	// Decision margin (AI count) at and above which zone checks run at max interval
+	protected static const float CHECK_INTERVAL_SAFE_MARGIN = 8;
+	
+	// Governor and collector update interval (in seconds)
+	protected static const float HOUSEKEEPING_INTERVAL = 1.0;
+	protected float m_fHousekeepingTimer = 0;
+	
+	// Timing scopes, created on first use
+	protected ref AFM_DiDProfiler m_Profiler;
+	protected float m_fProfilerLogTimer = 0;
+	
 	protected int m_iAttackersInActiveZone = 0;
 	protected int m_iDefendersRemaining = 0;
 	
+	// Attackers spawned by DiD spawners, used for zone presence checks
+	protected ref AFM_DiDAttackerRegistry m_AttackerRegistry = new AFM_DiDAttackerRegistry();
+	
+	// Alive defenders maintained from game mode events
+	protected ref AFM_DiDDefenderTracker m_DefenderTracker = new AFM_DiDDefenderTracker();
+	
+	// Pending group spawns of all spawners
+	protected ref AFM_DiDSpawnQueue m_SpawnQueue = new AFM_DiDSpawnQueue();
+	
+	// Next wave of every active spawner
+	protected ref AFM_DiDWaveScheduler m_WaveScheduler = new AFM_DiDWaveScheduler();
+	
+	// Entities of finished zones waiting for deletion
+	protected ref AFM_DiDDespawnQueue m_DespawnQueue = new AFM_DiDDespawnQueue();
+	
+	// Entities of the previous zone are being deleted, spawns wait for them
+	protected bool m_bZoneTeardown;
+	
+	// Surviving groups parked between zones, null when pooling is disabled
+	protected ref AFM_DiDGroupPool m_GroupPool;
+	
+	// Dynamic attacker AI budget, null when the governor is disabled
+	protected ref AFM_DiDAIGovernor m_AIGovernor;
+	
+	// Corpses and wrecks of attackers
+	protected ref AFM_DiDCollector m_Collector = new AFM_DiDCollector();
+	
+	// Collector deletions, kept apart from zone tear down so they never hold spawns back
+	protected ref AFM_DiDDespawnQueue m_CollectorQueue = new AFM_DiDDespawnQueue();
+	
+	// Spawner prefabs kept loaded for the whole mission
+	protected ref AFM_DiDPrefabCache m_PrefabCache = new AFM_DiDPrefabCache();
+	
+	// Incremental attacker census of the active zone, see m_iCensusAgentsPerFrame
+	protected ref AFM_DiDAttackerSweep m_AttackerSweep = new AFM_DiDAttackerSweep();
+	
 	// Callbacks
 	protected ref ScriptInvoker m_OnZoneChanged;
 	protected ref ScriptInvoker m_OnZoneUpdate;
@@ -23,6 +151,11 @@ class AFM_DiDZoneSystem: GameSystem
 	protected bool m_bIsSystemActive = false;
 	protected bool m_bSkipWarmup = false;
 	
+	// Zone readiness barrier, see StartZoneSystem
+	protected int m_iAnnouncedZones;
+	protected int m_iReadyZones;
+	protected bool m_bStartPending;
+	
 	protected const int m_iStartingZoneIndex = 1;
 	
 	//------------------------------------------------------------------------------------------------
@@ -59,14 +192,117 @@ class AFM_DiDZoneSystem: GameSystem
 		if (!m_bIsSystemActive)
 			return;
 		
-		m_fCheckTimer += args.GetTimeSliceSeconds();
+		if (m_AIGovernor)
+			m_AIGovernor.SampleTick(System.GetTickCount());
+		
+		if (m_AttackerSweep.IsRunning())
+			m_AttackerSweep.Step(m_iCensusAgentsPerFrame);
+		
+		m_WaveScheduler.Process(GetCurrentTimestamp());
+		
+		// Both queues run every frame with their own budgets, only the tear down of a finished zone
+		// holds spawns back until nothing deletable is left
+		int despawned = m_DespawnQueue.Process(Math.Max(1, m_iDespawnsPerFrame), m_DefenderTracker.GetAliveDefenders(), m_fDespawnVisibleDistance, m_fDespawnMaxDeferSeconds);
+		if (m_bZoneTeardown && despawned == 0)
+			m_bZoneTeardown = false;
+		
+		if (!m_bZoneTeardown)
+			m_SpawnQueue.Process(Math.Max(1, m_iSpawnsPerFrame), m_iSpawnBudgetMs);
+		
+		m_CollectorQueue.Process(Math.Max(1, m_iCollectorDespawnsPerFrame), m_DefenderTracker.GetAliveDefenders(), m_fDespawnVisibleDistance, m_fDespawnMaxDeferSeconds);
+		
+		float timeSlice = args.GetTimeSliceSeconds();
+		
+		// Governor and collector keep a fixed cadence regardless of the zone interval
+		m_fHousekeepingTimer += timeSlice;
+		if (m_fHousekeepingTimer >= HOUSEKEEPING_INTERVAL)
+		{
+			m_fHousekeepingTimer = 0;
+			
+			if (m_Profiler)
+				m_Profiler.CloseInterval();
+			
+			if (m_AIGovernor)
+				m_AIGovernor.Update(m_AttackerRegistry.Count());
+			
+			if (m_fProfilerLogInterval > 0)
+			{
+				m_fProfilerLogTimer += HOUSEKEEPING_INTERVAL;
+				if (m_fProfilerLogTimer >= m_fProfilerLogInterval)
+				{
+					m_fProfilerLogTimer = 0;
+					GetProfiler().PrintStats();
+				}
+			}
+			
+			if (m_bEnableCollector)
+				m_Collector.Update(m_DefenderTracker.GetAliveDefenders(), m_fCollectorCorpseAgeSeconds, m_fCollectorWreckAgeSeconds, m_fCollectorMinDistance, m_iCollectorMaxPerZone, m_CollectorQueue);
+		}
+		
+		m_fCheckTimer += timeSlice;
 		if (m_fCheckTimer < m_fCheckInterval)
 			return;
 
 		m_fCheckTimer = 0;
 
 		// Process the current zone
+		AFM_DiDProfiler profiler = GetProfiler();
+		int profileStart = profiler.Begin();
 		ProcessZone();
+		profiler.End("system.processZone", profileStart);
+		m_fCheckInterval = ComputeCheckInterval();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Time until the next zone tick
+	//! PREPARE ticks at the max interval to keep counts fresh, ACTIVE/FROZEN tick faster the
+	//! closer the freeze or fail decision is to flipping. Neither sleeps past the zone end
+	//------------------------------------------------------------------------------------------------
+	protected float ComputeCheckInterval()
+	{
+		float minInterval = Math.Max(0, m_fMinCheckInterval);
+		float maxInterval = Math.Max(minInterval, m_fMaxCheckInterval);
+		
+		if (!m_ActiveZone || !m_bIsSystemActive)
+			return maxInterval;
+		
+		EAFMZoneState state = m_ActiveZone.GetZoneState();
+		float untilDeadline = m_ActiveZone.GetZoneEndTime().DiffMilliseconds(GetCurrentTimestamp()) * 0.001;
+		
+		// Census still feeds the HUD while players join, die or respawn during warmup
+		if (state == EAFMZoneState.PREPARE)
+			return Math.Clamp(untilDeadline, minInterval, maxInterval);
+		
+		if (state != EAFMZoneState.ACTIVE && state != EAFMZoneState.FROZEN)
+			return maxInterval;
+		
+		AFM_DiDZoneCensus census = m_ActiveZone.GetCensus();
+		int defenders = census.m_iDefendersAlive;
+		
+		// Unknown counts, stay precise
+		if (defenders < 0 || census.m_iAttackersInside < 0)
+			return minInterval;
+		
+		int margin = defenders;
+		if (m_ActiveZone.IsFreezeEnabled())
+			margin = Math.Min(margin, Math.AbsInt(census.m_iAttackersInside - defenders));
+		
+		float t = Math.Clamp(margin / CHECK_INTERVAL_SAFE_MARGIN, 0, 1);
+		float interval = Math.Lerp(minInterval, maxInterval, t);
+		
+		// Frozen zones have no deadline running
+		if (state == EAFMZoneState.ACTIVE)
+			interval = Math.Min(interval, Math.Max(minInterval, untilDeadline));
+		
+		return interval;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Process the active zone on the next frame instead of waiting for the interval
+	//------------------------------------------------------------------------------------------------
+	void RequestZoneUpdate()
+	{
+		m_fCheckTimer = m_fCheckInterval;
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -84,23 +320,93 @@ class AFM_DiDZoneSystem: GameSystem
 		
 		if (m_aZones.Contains(zoneIndex))
 		{
-			PrintFormat("Zone %1 is already present at index %2", zone.GetZoneName(), zoneIndex, level: LogLevel.ERROR);
+			AFM_DiDLog.Write(EAFMDiDLogCategory.SYSTEM, LogLevel.ERROR, string.Format("Zone %1 is already present at index %2", zone.GetZoneName(), zoneIndex));
 			return false;
 		}
 		
 		m_aZones.Insert(zoneIndex, zone);
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Called by zones on post init, before their hierarchy is ready
+	//------------------------------------------------------------------------------------------------
+	void AnnounceZone(AFM_DiDZoneComponent zone)
+	{
+		m_iAnnouncedZones++;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Called by zones once they finished init, whether registration succeeded or not
+	//------------------------------------------------------------------------------------------------
+	void OnZoneReady(AFM_DiDZoneComponent zone)
+	{
+		m_iReadyZones++;
 		
-		//TODO: Add late init here
+		if (m_bStartPending && AreZonesReady())
+		{
+			GetGame().GetCallqueue().Remove(OnZoneReadyTimeout);
+			StartZoneSystemNow();
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool AreZonesReady()
+	{
+		return m_iReadyZones >= m_iAnnouncedZones;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void OnZoneReadyTimeout()
+	{
+		if (!m_bStartPending)
+			return;
 		
-		return true;
+		PrintFormat("AFM_DiDZoneSystem: Only %1/%2 zones ready after %3 seconds, starting anyway", m_iReadyZones, m_iAnnouncedZones, m_fZoneReadyTimeout, level: LogLevel.WARNING);
+		StartZoneSystemNow();
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Start zones once all announced zones are ready, waits at most m_fZoneReadyTimeout
 	//------------------------------------------------------------------------------------------------
 	void StartZoneSystem()
 	{
+		if (m_bStartPending)
+			return;
+		
+		if (AreZonesReady())
+		{
+			StartZoneSystemNow();
+			return;
+		}
+		
+		m_bStartPending = true;
+		PrintFormat("AFM_DiDZoneSystem: Waiting for %1/%2 zones to get ready", m_iAnnouncedZones - m_iReadyZones, m_iAnnouncedZones);
+		GetGame().GetCallqueue().CallLater(OnZoneReadyTimeout, m_fZoneReadyTimeout * 1000);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void StartZoneSystemNow()
+	{
+		m_bStartPending = false;
 		m_bIsSystemActive = true;
 		Enable(true);
 		
+		if (!m_GameMode)
+			m_GameMode = AFM_GameModeDiD.Cast(GetGame().GetGameMode());
+		
+		if (m_bEnableAIGovernor && !m_AIGovernor)
+			m_AIGovernor = new AFM_DiDAIGovernor(m_fGovernorTargetFPS, m_iGovernorMinAI, m_iGovernorMaxAI, m_iGovernorIncreaseStep);
+		
+		if (m_bEnableGroupPool && !m_GroupPool)
+			m_GroupPool = new AFM_DiDGroupPool(m_vGroupPoolHoldingPosition, m_iGroupPoolMaxGroups);
+		
+		if (m_GameMode)
+		{
+			m_DefenderTracker.Init(m_GameMode, m_GameMode.GetBluforFaction());
+			m_DefenderTracker.GetOnDefenderCountChanged().Insert(OnDefenderCountChanged);
+		}
+		
 		PrintFormat("AFM_DiDZoneSystem: Started zone system with %1 zones", m_aZones.Count());
 		
 		// Activate first zone in prepare phase
@@ -114,9 +420,7 @@ class AFM_DiDZoneSystem: GameSystem
 		} 
 		else
 		{
-			PrintFormat("AFM_DiDZoneSystem: Zone index %1 is invalid! Zone count: %2", 
-				m_iStartingZoneIndex, m_aZones.Count(), level:LogLevel.ERROR
-			);
+			AFM_DiDLog.Write(EAFMDiDLogCategory.SYSTEM, LogLevel.ERROR, string.Format("AFM_DiDZoneSystem: Zone index %1 is invalid! Zone count: %2", m_iStartingZoneIndex, m_aZones.Count()));
 			StopZoneSystem();
 		}
 	}
@@ -127,10 +431,9 @@ class AFM_DiDZoneSystem: GameSystem
 	
 	protected void ProcessZone()
 	{
-		WorldTimestamp tStart = GetCurrentTimestamp();
 		if (!m_ActiveZone)
 		{	
-			PrintFormat("AFM_DiDZoneSystem: Invalid active zone!", level:LogLevel.ERROR);
+			AFM_DiDLog.Write(EAFMDiDLogCategory.SYSTEM, LogLevel.ERROR, "AFM_DiDZoneSystem: Invalid active zone!");
 			return;
 		}
 		
@@ -148,6 +451,11 @@ class AFM_DiDZoneSystem: GameSystem
 			OnZoneStateChanged(zoneIndex, previousState, currentState);
 		}
 		
+		// Players respawned during PREPARE may not raise spawn events, rebuild the defender list
+		// before the first ACTIVE census decides whether the zone is lost
+		if (previousState == EAFMZoneState.PREPARE && currentState == EAFMZoneState.ACTIVE)
+			m_DefenderTracker.Resync();
+		
 		if (currentState == EAFMZoneState.FINISHED_HELD)
 		{
 			PrintFormat("AFM_DiDZoneSystem: Zone %1 defense time expired - defenders held!", zoneIndex);
@@ -165,8 +473,17 @@ class AFM_DiDZoneSystem: GameSystem
 			return;
 		}
 		
-		int attackersCount = m_ActiveZone.GetAICountInsideZone();
-		int defendersCount = m_ActiveZone.GetDefenderCount();
+		// Current zone settled into battle, get the next one ready
+		if (m_bPrewarmNextZone && previousState == EAFMZoneState.ACTIVE)
+			PrewarmNextZone();
+		
+		// Next census sweep runs over the frames until the next zone tick, slow sweeps carry over
+		if (IsIncrementalCensusEnabled() && !m_AttackerSweep.IsRunning())
+			m_AttackerSweep.Begin(m_AttackerRegistry, m_ActiveZone);
+		
+		AFM_DiDZoneCensus census = m_ActiveZone.GetCensus();
+		int attackersCount = census.m_iAttackersInside;
+		int defendersCount = census.m_iDefendersAlive;
 		bool sendUpdate = (attackersCount != m_iAttackersInActiveZone || defendersCount != m_iDefendersRemaining);
 		m_iAttackersInActiveZone = attackersCount;
 		m_iDefendersRemaining = defendersCount;
@@ -177,10 +494,20 @@ class AFM_DiDZoneSystem: GameSystem
 			if (m_OnZoneUpdate)
 				m_OnZoneUpdate.Invoke();
 		}
-		WorldTimestamp tEnd = GetCurrentTimestamp();
-		float diff = tEnd.DiffMilliseconds(tStart);
-		if (diff > 0)
-			PrintFormat("AFM_DiDZoneSystem: ProcessZone took %1 ms", tEnd.DiffMilliseconds(tStart), level: LogLevel.WARNING);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void PrewarmNextZone()
+	{
+		AFM_DiDZoneComponent nextZone = m_aZones.Get(m_ActiveZone.GetZoneIndex() + 1);
+		if (!nextZone || nextZone.IsPrewarmed())
+			return;
+		
+		AFM_DiDGroupPool stagingPool;
+		if (m_bStageNextZoneWave)
+			stagingPool = m_GroupPool;
+		
+		nextZone.Prewarm(stagingPool);
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -204,6 +531,30 @@ class AFM_DiDZoneSystem: GameSystem
 		}
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Process zone on the next frame when last defender dies, so the zone fails right after the
+	//! death event instead of at the end of the check interval
+	//------------------------------------------------------------------------------------------------
+	protected void OnDefenderCountChanged(int count)
+	{
+		if (count > 0 || !m_bIsSystemActive || !m_ActiveZone)
+			return;
+		
+		EAFMZoneState state = m_ActiveZone.GetZoneState();
+		if (state != EAFMZoneState.ACTIVE && state != EAFMZoneState.FROZEN)
+			return;
+		
+		// Respawned players only count once their spawn event arrives, rebuild the list before
+		// losing the zone on a count that may be missing them. Notifies again when it changes
+		m_DefenderTracker.Resync();
+		if (m_DefenderTracker.GetCount() > 0)
+			return;
+		
+		// Runs through the regular update so the tick is profiled and the interval recomputed,
+		// it also keeps zone progression out of the damage/kill callback stack
+		RequestZoneUpdate();
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	protected void ProgressToNextZone()
 	{
@@ -212,6 +563,7 @@ class AFM_DiDZoneSystem: GameSystem
 		{
 			newZoneIndex = m_ActiveZone.GetZoneIndex() + 1;
 			m_ActiveZone.DeactivateZone();
+			m_bZoneTeardown = true;
 		}
 		
 		m_ActiveZone = m_aZones[newZoneIndex];
@@ -252,6 +604,7 @@ class AFM_DiDZoneSystem: GameSystem
 		return m_ActiveZone.GetAICountInsideZone();
 	}
 	
+	//! Census value, so it matches the attacker count and what the zone state was decided on
 	int GetDefenderCount()
 	{
 		if (!m_ActiveZone)
@@ -260,6 +613,119 @@ class AFM_DiDZoneSystem: GameSystem
 		return m_ActiveZone.GetDefenderCount();
 	}
 	
+	AFM_DiDDefenderTracker GetDefenderTracker()
+	{
+		return m_DefenderTracker;
+	}
+	
+	AFM_DiDSpawnQueue GetSpawnQueue()
+	{
+		return m_SpawnQueue;
+	}
+	
+	AFM_DiDProfiler GetProfiler()
+	{
+		if (!m_Profiler)
+			m_Profiler = new AFM_DiDProfiler(m_iProfilerWindowSize);
+		
+		return m_Profiler;
+	}
+	
+	AFM_DiDWaveScheduler GetWaveScheduler()
+	{
+		return m_WaveScheduler;
+	}
+	
+	AFM_DiDDespawnQueue GetDespawnQueue()
+	{
+		return m_DespawnQueue;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Called when an agent leaves an attacker group, dead characters are handed to the collector
+	//------------------------------------------------------------------------------------------------
+	void OnAttackerRemoved(AIAgent agent)
+	{
+		if (!m_bEnableCollector || !agent)
+			return;
+		
+		SCR_ChimeraCharacter character = SCR_ChimeraCharacter.Cast(agent.GetControlledEntity());
+		if (!character)
+			return;
+		
+		SCR_DamageManagerComponent damageManager = character.GetDamageManager();
+		if (damageManager && damageManager.IsDestroyed())
+			m_Collector.AddCorpse(character, GetCurrentZoneIndex());
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Track spawned vehicle, collected once destroyed
+	//------------------------------------------------------------------------------------------------
+	void RegisterSpawnedVehicle(IEntity vehicle)
+	{
+		if (m_bEnableCollector)
+			m_Collector.AddVehicle(vehicle, GetCurrentZoneIndex());
+	}
+	
+	AFM_DiDCollector GetCollector()
+	{
+		return m_Collector;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Attacker AI budget of the governor, -1 when the governor is disabled
+	//------------------------------------------------------------------------------------------------
+	int GetAIBudget()
+	{
+		if (!m_AIGovernor)
+			return -1;
+		
+		return m_AIGovernor.GetBudget();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Fraction of the governor max budget currently granted, 1 when the governor is disabled
+	//------------------------------------------------------------------------------------------------
+	float GetAIBudgetScale()
+	{
+		if (!m_AIGovernor || m_AIGovernor.GetMaxBudget() <= 0)
+			return 1;
+		
+		float budget = m_AIGovernor.GetBudget();
+		return budget / m_AIGovernor.GetMaxBudget();
+	}
+	
+	AFM_DiDAIGovernor GetAIGovernor()
+	{
+		return m_AIGovernor;
+	}
+	
+	//! Null when group pooling is disabled
+	AFM_DiDGroupPool GetGroupPool()
+	{
+		return m_GroupPool;
+	}
+	
+	AFM_DiDPrefabCache GetPrefabCache()
+	{
+		return m_PrefabCache;
+	}
+	
+	bool IsIncrementalCensusEnabled()
+	{
+		return m_iCensusAgentsPerFrame > 0;
+	}
+	
+	AFM_DiDAttackerSweep GetAttackerSweep()
+	{
+		return m_AttackerSweep;
+	}
+	
+	AFM_DiDAttackerRegistry GetAttackerRegistry()
+	{
+		return m_AttackerRegistry;
+	}
+	
 	AFM_PlayerSpawnPointEntity GetCurrentZonePlayerSpawnPoint()
 	{
 		if (!m_ActiveZone)
@@ -268,6 +734,11 @@ class AFM_DiDZoneSystem: GameSystem
 		return m_ActiveZone.GetPlayerSpawnPoint();
 	}
 	
+	AFM_DiDZoneComponent GetActiveZone()
+	{
+		return m_ActiveZone;
+	}
+	
 	int GetCurrentZoneIndex()
 	{
 		if (m_ActiveZone)
@@ -311,6 +782,7 @@ class AFM_DiDZoneSystem: GameSystem
 			return;
 		
 		m_ActiveZone.ForceEndPrepareStage();
+		RequestZoneUpdate();
 	}
 	
 	WorldTimestamp GetCurrentTimestamp()
@@ -324,12 +796,25 @@ class AFM_DiDZoneSystem: GameSystem
 	{
 		Enable(false);
 		m_bIsSystemActive = false;
+		m_DefenderTracker.GetOnDefenderCountChanged().Remove(OnDefenderCountChanged);
+		m_DefenderTracker.Deinit();
+		m_AttackerSweep.Reset();
+		m_SpawnQueue.Clear();
+		m_WaveScheduler.Clear();
 		// Deactivate all zones
 		foreach (AFM_DiDZoneComponent zone : m_aZones)
 		{
 			if (zone)
 				zone.DeactivateZone();
 		}
+		
+		// System stops updating, nothing would drain the queue anymore
+		m_DespawnQueue.Flush();
+		m_CollectorQueue.Flush();
+		m_bZoneTeardown = false;
+		
+		if (m_GroupPool)
+			m_GroupPool.Clear();
 	}
 	
 	ScriptInvoker GetOnZoneChanged()
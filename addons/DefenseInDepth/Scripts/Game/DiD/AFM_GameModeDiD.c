@@ -4,12 +4,21 @@ class AFM_GameModeDiDClass: PS_GameModeCoopClass
 
 class AFM_GameModeDiD: PS_GameModeCoop
 {
+	// Time after respawning spectators before alive defenders are counted again
+	protected static const int RESPAWN_RESYNC_DELAY_MS = 3000;
+	
 	[Attribute("US", UIWidgets.EditBox, "Defenders faction key", category: "DiD")]
 	protected FactionKey m_sDefenderFactionKey;
 	
 	[Attribute("USSR", UIWidgets.EditBox, "Attackers faction key", category: "DiD")]
 	protected FactionKey m_sAttackerFactionKey;	
 	
+	[Attribute("", UIWidgets.EditBox, "DiD log levels, e.g. \"spawner=debug,mortar=verbose\" or \"debug\". -didLog CLI parameter overrides it", category: "DiD")]
+	protected string m_sDiDLogLevels;
+	
+	[Attribute("0", UIWidgets.EditBox, "Lines below the log level kept in memory and written out on the next error (0 = disabled). Enabling it formats debug lines of all categories", category: "DiD", params: "0 inf")]
+	protected int m_iDiDLogBufferSize;
+	
 	protected SCR_FactionManager m_FactionManager;
 	protected AFM_DiDZoneSystem m_ZoneSystem;
 	protected ref ScriptInvoker m_OnMatchSituationChanged;
@@ -75,17 +84,19 @@ class AFM_GameModeDiD: PS_GameModeCoop
 		if (SCR_Global.IsEditMode())
 			return;
 		
+		AFM_DiDLog.Init(m_sDiDLogLevels, m_iDiDLogBufferSize);
+		
 		m_FactionManager = SCR_FactionManager.Cast(GetGame().GetFactionManager());
 		if (!m_FactionManager)
 		{
-			Print("Faction manager component is missing!", LogLevel.ERROR);
+			AFM_DiDLog.Write(EAFMDiDLogCategory.SYSTEM, LogLevel.ERROR, "Faction manager component is missing!");
 		}
 		
 		
 		m_ZoneSystem = AFM_DiDZoneSystem.GetInstance();
 		if (!m_ZoneSystem)
 		{
-			Print("AFM_DiDZoneSystem is missing", LogLevel.ERROR);
+			AFM_DiDLog.Write(EAFMDiDLogCategory.SYSTEM, LogLevel.ERROR, "AFM_DiDZoneSystem is missing");
 		}
 		else
 		{
@@ -180,6 +191,17 @@ class AFM_GameModeDiD: PS_GameModeCoop
 				RespawnPlayer(playerId, pcomp, currentSpawnPoint);
 			}
 		}
+		
+		// Respawns finish over the next frames and may not raise the spawn event the defender
+		// tracker listens to, pick the respawned players up once they are in control
+		GetGame().GetCallqueue().CallLater(ResyncDefenders, RESPAWN_RESYNC_DELAY_MS);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void ResyncDefenders()
+	{
+		if (m_ZoneSystem)
+			m_ZoneSystem.GetDefenderTracker().Resync();
 	}
 	
 	protected void RespawnPlayer(int playerId, PS_PlayableComponent playableComponent, AFM_PlayerSpawnPointEntity sp)
@@ -28,36 +28,23 @@ class AFM_DiDInfantrySpawnerComponent: AFM_DiDSpawnerComponent
 	override void Prepare(AFM_DiDZoneComponent owner)
 	{
 		super.Prepare(owner);
-		PrintFormat("AFM_DiDInfantrySpawnerComponent: Infantry spawner initialized with %1 spawn points and %2 waypoints", 
-			m_aSpawnPoints.Count(), m_aAIWaypoints.Count(), LogLevel.DEBUG);
+		if (AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG))
+			AFM_DiDLog.Write(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG, string.Format("AFM_DiDInfantrySpawnerComponent: Infantry spawner initialized with %1 spawn points and %2 waypoints", m_aSpawnPoints.Count(), m_aAIWaypoints.Count()));
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	override protected bool CanPoolGroups()
+	{
+		return true;
 	}
 	
 	//------------------------------------------------------------------------------------------------
 	//! Override to add variety to spawn intervals
 	//------------------------------------------------------------------------------------------------
-	override void Process()
+	override protected float GetNextWaveInterval()
 	{
-		if (!m_Zone)
-			return;
-		
-		EAFMZoneState state = m_Zone.GetZoneState();
-		if (state != EAFMZoneState.ACTIVE && state != EAFMZoneState.FROZEN)
-			return;
-		
-		ChimeraWorld world = GetGame().GetWorld();
-		WorldTimestamp now = world.GetServerTimestamp();
-		
-		int timeSinceLastSpawn = Math.AbsInt(now.DiffSeconds(m_fLastSpawnTime));
-		
-		// Add variety to spawn intervals
 		float intervalMultiplier = s_AIRandomGenerator.RandFloatXY(m_fMinIntervalMultiplier, m_fMaxIntervalMultiplier);
-		int adjustedInterval = Math.Ceil(m_iWaveIntervalSeconds * intervalMultiplier);
-		
-		if (timeSinceLastSpawn >= adjustedInterval)
-		{
-			m_fLastSpawnTime = now;
-			SpawnWave();
-		}
+		return m_iWaveIntervalSeconds * intervalMultiplier;
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -97,8 +84,9 @@ class AFM_DiDInfantrySpawnerComponent: AFM_DiDSpawnerComponent
 		AIGroup group = SpawnAI(groupPrefab, spawnPoint, waypoint);
 		if (group)
 		{
-			m_aSpawnedAIGroups.Insert(group);
-			PrintFormat("AFM_DiDInfantrySpawnerComponent: Spawned infantry group %1", groupPrefab, LogLevel.DEBUG);
+			AddSpawnedGroup(group);
+			if (AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG))
+				AFM_DiDLog.Write(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG, string.Format("AFM_DiDInfantrySpawnerComponent: Spawned infantry group %1", groupPrefab));
 		}
 	}
 }
@@ -37,8 +37,26 @@ class AFM_DiDMechanizedSpawnerComponent: AFM_DiDSpawnerComponent
 		// Mechanized units spawn less frequently
 		m_iWaveIntervalSeconds = Math.Ceil(m_iWaveIntervalSeconds * m_fDelayMultiplier);
 		
-		PrintFormat("AFM_DiDMechanizedSpawnerComponent: Mechanized spawner initialized with %1s interval", 
-			m_iWaveIntervalSeconds, LogLevel.DEBUG);
+		if (AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG))
+			AFM_DiDLog.Write(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG, string.Format("AFM_DiDMechanizedSpawnerComponent: Mechanized spawner initialized with %1s interval", m_iWaveIntervalSeconds));
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Vehicle crews cannot be parked outside their vehicles, nothing to stage
+	//------------------------------------------------------------------------------------------------
+	override void StageFirstWave(notnull AFM_DiDGroupPool pool)
+	{
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	override void CollectPrefabs(notnull array<ResourceName> outPrefabs)
+	{
+		super.CollectPrefabs(outPrefabs);
+		
+		if (m_aVehiclePrefabs)
+			outPrefabs.InsertAll(m_aVehiclePrefabs);
+		if (m_crewConfig)
+			m_crewConfig.CollectPrefabs(outPrefabs);
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -50,22 +68,17 @@ class AFM_DiDMechanizedSpawnerComponent: AFM_DiDSpawnerComponent
 			int currentAI = m_Zone.GetActiveAICount();
 			if (currentAI < m_iMinAIThreshold)
 			{
-				PrintFormat("AFM_DiDMechanizedSpawnerComponent: Waiting for minimum AI threshold (%1/%2)", 
-					currentAI, m_iMinAIThreshold, LogLevel.DEBUG);
+				if (AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG))
+					AFM_DiDLog.Write(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG, string.Format("AFM_DiDMechanizedSpawnerComponent: Waiting for minimum AI threshold (%1/%2)", currentAI, m_iMinAIThreshold));
 				return;
 			}
 		}
 		
 		int spawnCount = GetSpawnCountForWave();
-		PrintFormat("AFM_DiDSpawnerComponent: Spawning wave with %1 groups", spawnCount, LogLevel.DEBUG);
+		if (AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG))
+			AFM_DiDLog.Write(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG, string.Format("AFM_DiDSpawnerComponent: Spawning wave with %1 groups", spawnCount));
 		
-		for (int i = 0; i < spawnCount; i++)
-		{
-			if (m_Zone.GetActiveAICount() >= m_iMaxAICount)
-				break;
-			
-			SpawnSingleGroup();
-		}
+		QueueSpawns(spawnCount);
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -74,10 +87,9 @@ class AFM_DiDMechanizedSpawnerComponent: AFM_DiDSpawnerComponent
 		super.Cleanup();
 		foreach(IEntity entity: m_aSpawnedVehicles)
 		{
-			if (!entity)
-				continue;
-			SCR_EntityHelper.DeleteEntityAndChildren(entity);
+			Despawn(entity);
 		}
+		m_aSpawnedVehicles.Clear();
 	}
 	
 	
@@ -118,6 +130,7 @@ class AFM_DiDMechanizedSpawnerComponent: AFM_DiDSpawnerComponent
 		if (!vehicle)
 			return;
 		m_aSpawnedVehicles.Insert(vehicle);
+		AFM_DiDZoneSystem.GetInstance().RegisterSpawnedVehicle(vehicle);
 		
 		SCR_BaseCompartmentManagerComponent cm = SCR_BaseCompartmentManagerComponent.Cast(vehicle.FindComponent(SCR_BaseCompartmentManagerComponent));
 		if (!cm)
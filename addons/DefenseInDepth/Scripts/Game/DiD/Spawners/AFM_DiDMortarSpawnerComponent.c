@@ -1,6 +1,13 @@
+//------------------------------------------------------------------------------------------------
+enum EAFMMortarTargetingMode
+{
+	MONTE_CARLO,	// Random samples in zone bounds, cost grows with samples * defenders
+	DENSITY_GRID	// Defender density grid over zone bounds, exact on the grid for a fixed cost
+}
+
 //------------------------------------------------------------------------------------------------
 //! Mortar fire support spawner - spawns mortar teams with intelligent target selection
-//! Uses Monte Carlo sampling to find optimal fire positions within the zone
+//! Picks the fire position inside the zone with most defenders around it
 //------------------------------------------------------------------------------------------------
 class AFM_DiDMortarSpawnerComponentClass: AFM_DiDSpawnerComponentClass
 {
@@ -9,6 +16,21 @@ class AFM_DiDMortarSpawnerComponentClass: AFM_DiDSpawnerComponentClass
 //------------------------------------------------------------------------------------------------
 class AFM_DiDMortarSpawnerComponent: AFM_DiDSpawnerComponent
 {
+	protected static const ResourceName FIRE_WAYPOINT_PREFAB = "{C524700A27CFECDD}Prefabs/AI/Waypoints/AIWaypoint_ArtillerySupport.et";
+	
+	// Longest triangle edge of the sampling domain, keeps clipping to the range annulus tight
+	protected static const float SAMPLING_MAX_EDGE = 50;
+	
+	// Targets closer than this to the current one keep the crew on its running fire mission
+	protected static const float RETARGET_DISTANCE = 5;
+	
+	// Coarse candidates refined by Monte Carlo targeting
+	protected static const int REFINE_CANDIDATES = 3;
+	
+	// Synthetic defender layout used by BenchmarkTargeting
+	protected static const int BENCHMARK_CLUSTERS = 3;
+	protected static const int BENCHMARK_SCATTERED = 10;
+	
 	[Attribute("", UIWidgets.Object, desc: "Crew configuration for mortar", category: "DiD Mortar Spawner")]
 	protected ref AFM_CrewConfig m_crewConfig;
 	
@@ -18,9 +40,21 @@ class AFM_DiDMortarSpawnerComponent: AFM_DiDSpawnerComponent
 	[Attribute("30", UIWidgets.EditBox, "Fire mission update interval (seconds)", category: "DiD Mortar Spawner")]
 	protected int m_iFireMissionUpdateInterval;
 	
+	[Attribute("1", UIWidgets.ComboBox, "Target selection method", category: "DiD Mortar Spawner", enums: ParamEnumArray.FromEnum(EAFMMortarTargetingMode))]
+	protected EAFMMortarTargetingMode m_eTargetingMode;
+	
+	[Attribute("5", UIWidgets.EditBox, "Density grid cell size (meters), only used by DENSITY_GRID targeting", category: "DiD Mortar Spawner", params: "1 inf")]
+	protected float m_fTargetingCellSize;
+	
 	[Attribute("10", UIWidgets.EditBox, "Number of sample points for Monte Carlo targeting (higher = more accurate, slower)", category: "DiD Mortar Spawner")]
 	protected int m_iMonteCarloSamples;
 	
+	[Attribute("1", UIWidgets.ComboBox, "Sample point distribution for Monte Carlo targeting", category: "DiD Mortar Spawner", enums: ParamEnumArray.FromEnum(EAFMMortarSampler))]
+	protected EAFMMortarSampler m_eSampler;
+	
+	[Attribute("0.3", UIWidgets.Slider, "Share of Monte Carlo samples spent around the best coarse candidates (0 = no refinement)", category: "DiD Mortar Spawner", params: "0 0.9 0.05")]
+	protected float m_fRefineFraction;
+	
 	[Attribute("50", UIWidgets.EditBox, "Radius (meters) around each sample point to check for targets", category: "DiD Mortar Spawner")]
 	protected float m_fSampleRadius;
 	
@@ -38,9 +72,10 @@ class AFM_DiDMortarSpawnerComponent: AFM_DiDSpawnerComponent
 	protected ref map<IEntity, ref MortarFireMissionData> m_mFireMissions = new map<IEntity, ref MortarFireMissionData>();
 	protected WorldTimestamp m_fLastTargetUpdate;
 	protected ref array<Shape> m_aDebugShapes = {};
+	protected ref AFM_DiDDensityGrid m_DensityGrid;
 	
-	//calculate only once
-	protected ref array<float> m_aPolylinePoints2D = null;
+	// Zone sampling domain clipped to mortar range, one per spawn point
+	protected ref array<ref AFM_DiDSamplingDomain> m_aSamplingDomains = {};
 	
 	//------------------------------------------------------------------------------------------------
 	override void Prepare(AFM_DiDZoneComponent owner)
@@ -50,12 +85,50 @@ class AFM_DiDMortarSpawnerComponent: AFM_DiDSpawnerComponent
 		ChimeraWorld world = GetGame().GetWorld();
 		m_fLastTargetUpdate = world.GetServerTimestamp();
 		
-		PrintFormat("AFM_DiDMortarSpawnerComponent: Mortar spawner initialized with %1 MC samples, %2m radius", 
-			m_iMonteCarloSamples, m_fSampleRadius, LogLevel.DEBUG);
+		BakeSamplingDomains();
+		
+		// Zone polygon does not change, grid layout is computed once
+		if (m_eTargetingMode == EAFMMortarTargetingMode.DENSITY_GRID)
+		{
+			m_DensityGrid = new AFM_DiDDensityGrid();
+			if (!m_DensityGrid.Init(m_Zone.GetGeometry(), m_fTargetingCellSize, m_fSampleRadius))
+				PrintFormat("AFM_DiDMortarSpawnerComponent: Density grid could not be built, using Monte Carlo targeting", level: LogLevel.WARNING);
+		}
+		
+		if (AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.MORTAR, LogLevel.DEBUG))
+			AFM_DiDLog.Write(EAFMDiDLogCategory.MORTAR, LogLevel.DEBUG, string.Format("AFM_DiDMortarSpawnerComponent: Mortar spawner initialized with %1 targeting, %2m radius", typename.EnumToString(EAFMMortarTargetingMode, m_eTargetingMode), m_fSampleRadius));
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Triangulate zone once and clip it to the range annulus around every spawn point
+	//------------------------------------------------------------------------------------------------
+	protected void BakeSamplingDomains()
+	{
+		m_aSamplingDomains.Clear();
+		
+		AFM_DiDZoneGeometry geometry = m_Zone.GetGeometry();
+		if (!geometry.IsValid())
+			return;
+		
+		AFM_DiDSamplingDomain zoneDomain = new AFM_DiDSamplingDomain();
+		if (!zoneDomain.Build(geometry.GetPoints2D(), SAMPLING_MAX_EDGE))
+		{
+			PrintFormat("AFM_DiDMortarSpawnerComponent: Failed to triangulate zone %1", m_Zone.GetZoneName(), level: LogLevel.WARNING);
+			return;
+		}
+		
+		foreach (AFM_SpawnPointEntity spawnPoint : m_aSpawnPoints)
+		{
+			AFM_DiDSamplingDomain domain = zoneDomain.ClipToAnnulus(spawnPoint.GetOrigin(), m_fMinTargetDistance, m_fMaxTargetDistance);
+			if (domain.IsEmpty())
+				PrintFormat("AFM_DiDMortarSpawnerComponent: No part of zone %1 is in range of spawn point at %2", m_Zone.GetZoneName(), spawnPoint.GetOrigin(), level: LogLevel.WARNING);
+			
+			m_aSamplingDomains.Insert(domain);
+		}
 	}
 	
 	//------------------------------------------------------------------------------------------------
-	override void Process()
+	override void Process(AFM_DiDZoneCensus census)
 	{
 		if (!m_Zone)
 			return;
@@ -67,7 +140,8 @@ class AFM_DiDMortarSpawnerComponent: AFM_DiDSpawnerComponent
 		
 		if (!m_SpawnedMortar)
 		{
-			SpawnSingleGroup();
+			if (m_iPendingSpawns == 0)
+				QueueSpawns(1);
 			return;
 		}
 		
@@ -77,19 +151,69 @@ class AFM_DiDMortarSpawnerComponent: AFM_DiDSpawnerComponent
 		if (now.DiffSeconds(m_fLastTargetUpdate) >= m_iFireMissionUpdateInterval)
 		{
 			m_fLastTargetUpdate = now;
-			UpdateAllFireMissions();
+			UpdateAllFireMissions(census);
 		}
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Mortar is spawned and tasked from Process, no waves
+	//------------------------------------------------------------------------------------------------
+	override void StartWaves()
+	{
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	override void Cleanup()
 	{
 		super.Cleanup();
-		SCR_EntityHelper.DeleteEntityAndChildren(m_SpawnedMortar);
+		Despawn(m_SpawnedMortar);
+		m_SpawnedMortar = null;
 		
+		// Waypoints of running fire missions are not owned by anything else
+		foreach (IEntity mortar, MortarFireMissionData fireMission : m_mFireMissions)
+		{
+			if (fireMission)
+				Despawn(fireMission.m_CurrentWaypoint);
+		}
 		m_mFireMissions.Clear();
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Mortar crew is spawned with its mortar, nothing to stage
+	//------------------------------------------------------------------------------------------------
+	override void StageFirstWave(notnull AFM_DiDGroupPool pool)
+	{
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	override void CollectPrefabs(notnull array<ResourceName> outPrefabs)
+	{
+		super.CollectPrefabs(outPrefabs);
+		
+		outPrefabs.Insert(m_MortarPrefab);
+		outPrefabs.Insert(FIRE_WAYPOINT_PREFAB);
+		if (m_crewConfig)
+			m_crewConfig.CollectPrefabs(outPrefabs);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Mortar is not counted against the AI limit, only one is kept alive
+	//------------------------------------------------------------------------------------------------
+	override protected bool CanExecuteSpawn()
+	{
+		if (!m_Zone || m_SpawnedMortar)
+			return false;
+		
+		EAFMZoneState state = m_Zone.GetZoneState();
+		return state == EAFMZoneState.ACTIVE || state == EAFMZoneState.FROZEN;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	override float GetAIBudgetWeight()
+	{
+		return 0;
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	override protected int GetSpawnCountForWave()
 	{
@@ -102,30 +226,32 @@ class AFM_DiDMortarSpawnerComponent: AFM_DiDSpawnerComponent
 	{
 		if (m_aSpawnPoints.Count() == 0 || m_MortarPrefab.IsEmpty())
 		{
-			PrintFormat("AFM_DiDMortarSpawnerComponent: No spawn points or mortar prefabs configured!", LogLevel.WARNING);
+			PrintFormat("AFM_DiDMortarSpawnerComponent: No spawn points or mortar prefabs configured!", level: LogLevel.WARNING);
 			return;
 		}
 		
 		if (!m_crewConfig)
 		{
-			PrintFormat("AFM_DiDMortarSpawnerComponent: No crew config defined!", LogLevel.ERROR);
+			AFM_DiDLog.Write(EAFMDiDLogCategory.MORTAR, LogLevel.ERROR, "AFM_DiDMortarSpawnerComponent: No crew config defined!");
 			return;
 		}
 		
 		// Spawn mortar vehicle
-		AFM_SpawnPointEntity spawnPoint = m_aSpawnPoints.GetRandomElement();
+		int spawnPointIndex = m_aSpawnPoints.GetRandomIndex();
+		AFM_SpawnPointEntity spawnPoint = m_aSpawnPoints[spawnPointIndex];
 		
 		EntitySpawnParams spawnParams = new EntitySpawnParams();
 		vector mat[4];
 		spawnPoint.GetWorldTransform(mat);
 		spawnParams.Transform = mat;
 		
-		m_SpawnedMortar = GetGame().SpawnEntityPrefab(Resource.Load(m_MortarPrefab), GetGame().GetWorld(), spawnParams);
+		m_SpawnedMortar = GetGame().SpawnEntityPrefab(AFM_DiDPrefabCache.Load(m_MortarPrefab), GetGame().GetWorld(), spawnParams);
 		if (!m_SpawnedMortar)
 		{
-			PrintFormat("AFM_DiDMortarSpawnerComponent: Failed to spawn mortar!", LogLevel.ERROR);
+			AFM_DiDLog.Write(EAFMDiDLogCategory.MORTAR, LogLevel.ERROR, "AFM_DiDMortarSpawnerComponent: Failed to spawn mortar!");
 			return;
 		}
+		AFM_DiDZoneSystem.GetInstance().RegisterSpawnedVehicle(m_SpawnedMortar);
 		
 		// Get compartment manager and crew the mortar
 		SCR_BaseCompartmentManagerComponent cm = SCR_BaseCompartmentManagerComponent.Cast(
@@ -134,7 +260,7 @@ class AFM_DiDMortarSpawnerComponent: AFM_DiDSpawnerComponent
 		
 		if (!cm)
 		{
-			PrintFormat("AFM_DiDMortarSpawnerComponent: Mortar has no compartment manager!", LogLevel.ERROR);
+			AFM_DiDLog.Write(EAFMDiDLogCategory.MORTAR, LogLevel.ERROR, "AFM_DiDMortarSpawnerComponent: Mortar has no compartment manager!");
 			return;
 		}
 		
@@ -142,12 +268,14 @@ class AFM_DiDMortarSpawnerComponent: AFM_DiDSpawnerComponent
 		MortarFireMissionData fireMission = new MortarFireMissionData();
 		fireMission.m_Mortar = m_SpawnedMortar;
 		fireMission.m_SpawnPosition = m_SpawnedMortar.GetOrigin();
+		if (m_aSamplingDomains.IsIndexValid(spawnPointIndex))
+			fireMission.m_SamplingDomain = m_aSamplingDomains[spawnPointIndex];
 		
 		// Crew the mortar (gunner only, no waypoint yet)
 		AIGroup crew = m_crewConfig.SpawnCrew(cm, null);
 		if (!crew)
 		{
-			PrintFormat("AFM_DiDMortarSpawnerComponent: Failed to spawn mortar crew!", LogLevel.ERROR);
+			AFM_DiDLog.Write(EAFMDiDLogCategory.MORTAR, LogLevel.ERROR, "AFM_DiDMortarSpawnerComponent: Failed to spawn mortar crew!");
 			return;
 		}
 		
@@ -155,196 +283,367 @@ class AFM_DiDMortarSpawnerComponent: AFM_DiDSpawnerComponent
 		m_mFireMissions.Set(m_SpawnedMortar, fireMission);
 		
 		// Create initial fire mission
-		UpdateFireMission(fireMission);
+		UpdateFireMission(fireMission, m_Zone.GetCensus());
 		
-		PrintFormat("AFM_DiDMortarSpawnerComponent: Spawned mortar at %1", m_SpawnedMortar.GetOrigin(), LogLevel.DEBUG);
+		if (AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.MORTAR, LogLevel.DEBUG))
+			AFM_DiDLog.Write(EAFMDiDLogCategory.MORTAR, LogLevel.DEBUG, string.Format("AFM_DiDMortarSpawnerComponent: Spawned mortar at %1", m_SpawnedMortar.GetOrigin()));
 	}
 	
 	//------------------------------------------------------------------------------------------------
 	//! Update fire missions for all spawned mortars
 	//------------------------------------------------------------------------------------------------
-	protected void UpdateAllFireMissions()
+	protected void UpdateAllFireMissions(AFM_DiDZoneCensus census)
 	{
 		foreach (IEntity mortar, MortarFireMissionData fireMission : m_mFireMissions)
 		{
 			if (mortar && fireMission)
-				UpdateFireMission(fireMission);
+				UpdateFireMission(fireMission, census);
 		}
 	}
 	
 	//------------------------------------------------------------------------------------------------
-	//! Update fire mission for a specific mortar using Monte Carlo target selection
+	//! Update fire mission for a specific mortar
 	//------------------------------------------------------------------------------------------------
-	protected void UpdateFireMission(MortarFireMissionData fireMission)
+	protected void UpdateFireMission(MortarFireMissionData fireMission, AFM_DiDZoneCensus census)
 	{
 		if (!fireMission || !fireMission.m_Mortar || !fireMission.m_CrewGroup)
 			return;
 		
-		// Find best target position using Monte Carlo sampling
-		vector targetPos = FindBestTargetPosition(fireMission.m_SpawnPosition);
+		// Find best target position
+		AFM_DiDProfiler profiler = AFM_DiDZoneSystem.GetInstance().GetProfiler();
+		int profileStart = profiler.Begin();
+		int targetCount;
+		vector targetPos = FindBestTargetPosition(fireMission, census, targetCount);
+		profiler.End("mortar.targeting", profileStart);
+		fireMission.m_LastTargetCount = targetCount;
 		
 		if (targetPos == vector.Zero)
 		{
-			PrintFormat("AFM_DiDMortarSpawnerComponent: No valid target found for mortar", LogLevel.DEBUG);
+			if (AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.MORTAR, LogLevel.DEBUG))
+				AFM_DiDLog.Write(EAFMDiDLogCategory.MORTAR, LogLevel.DEBUG, "AFM_DiDMortarSpawnerComponent: No valid target found for mortar");
 			return;
 		}
 		
-		// Create or update fire position waypoint
-		SCR_AIWaypointArtillerySupport fireWaypoint = CreateFirePositionWaypoint(targetPos, fireMission);
+		// Fire mission keeps one waypoint for its lifetime, it is only moved and re-armed
+		SCR_AIWaypointArtillerySupport fireWaypoint = fireMission.m_CurrentWaypoint;
+		bool retarget = !fireWaypoint || vector.DistanceSqXZ(fireMission.m_TargetPosition, targetPos) > RETARGET_DISTANCE * RETARGET_DISTANCE;
 		
 		if (!fireWaypoint)
 		{
-			PrintFormat("AFM_DiDMortarSpawnerComponent: Failed to create fire waypoint!", LogLevel.ERROR);
-			return;
+			fireWaypoint = CreateFirePositionWaypoint(targetPos);
+			if (!fireWaypoint)
+			{
+				AFM_DiDLog.Write(EAFMDiDLogCategory.MORTAR, LogLevel.ERROR, "AFM_DiDMortarSpawnerComponent: Failed to create fire waypoint!");
+				return;
+			}
+			fireMission.m_CurrentWaypoint = fireWaypoint;
+		}
+		else if (retarget)
+		{
+			PlaceFirePositionWaypoint(fireWaypoint, targetPos);
 		}
 		
 		//TODO: Add different fire mission types and mortar count
 		fireWaypoint.SetTargetShotCount(s_AIRandomGenerator.RandInt(1,6));
 		
-		// Clear existing waypoints and assign new one
-		array<AIWaypoint> existingWaypoints = {};
-		fireMission.m_CrewGroup.GetWaypoints(existingWaypoints);
-		
-		foreach (AIWaypoint wp : existingWaypoints)
-		{
-			fireMission.m_CrewGroup.RemoveWaypoint(wp);
-			// Clean up old dynamic waypoint
-			if (fireMission.m_CurrentWaypoint == wp)
-				SCR_EntityHelper.DeleteEntityAndChildren(wp);
-		}
+		AssignFirePositionWaypoint(fireMission.m_CrewGroup, fireWaypoint, retarget);
 		
-		fireMission.m_CrewGroup.AddWaypoint(fireWaypoint);
-		fireMission.m_CurrentWaypoint = fireWaypoint;
-		fireMission.m_TargetPosition = targetPos;
+		if (retarget)
+			fireMission.m_TargetPosition = targetPos;
 		fireMission.m_LastUpdateTime = GetCurrentTimestamp();
 		
-		PrintFormat("AFM_DiDMortarSpawnerComponent: Updated fire mission to %1 (%2 targets)", 
-			targetPos.ToString(), fireMission.m_LastTargetCount, LogLevel.DEBUG);
+		if (AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.MORTAR, LogLevel.DEBUG))
+			AFM_DiDLog.Write(EAFMDiDLogCategory.MORTAR, LogLevel.DEBUG, string.Format("AFM_DiDMortarSpawnerComponent: Updated fire mission to %1 (%2 targets)", targetPos, fireMission.m_LastTargetCount));
 	}
 	
 	//------------------------------------------------------------------------------------------------
-	//! Monte Carlo sampling to find best target position
 	//! Returns position with most defender units within sample radius
+	//! @param[out] targetCount Defenders around returned position
 	//------------------------------------------------------------------------------------------------
-	protected vector FindBestTargetPosition(vector mortarPos)
+	protected vector FindBestTargetPosition(MortarFireMissionData fireMission, AFM_DiDZoneCensus census, out int targetCount)
 	{
-		if (!m_Zone)
-			return vector.Zero;
+		if (m_eTargetingMode == EAFMMortarTargetingMode.DENSITY_GRID)
+			return FindBestTargetPositionGrid(fireMission, census, targetCount);
 		
-		//TODO: Move below calculations to init (they need to happen only once)
-		// Get zone boundary for sampling
-		PolylineShapeEntity polyline = m_Zone.GetPolylineEntity();
-		if (!polyline)
+		return FindBestTargetPositionMonteCarlo(fireMission, census, targetCount);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Argmax of the defender density grid, built from census in O(defenders)
+	//------------------------------------------------------------------------------------------------
+	protected vector FindBestTargetPositionGrid(MortarFireMissionData fireMission, AFM_DiDZoneCensus census, out int targetCount)
+	{
+		targetCount = -1;
+		if (!m_Zone || !census)
 			return vector.Zero;
 		
-		array<vector> polylinePoints = {};
-		polyline.GetPointsPositions(polylinePoints);
+		// Laid out in Prepare
+		if (!m_DensityGrid || !m_DensityGrid.IsValid())
+			return FindBestTargetPositionMonteCarlo(fireMission, census, targetCount);
+		
+		m_DensityGrid.Build(census.m_aDefenderPositions);
+		vector bestPosition = m_DensityGrid.FindBest(fireMission.m_SpawnPosition, m_fMinTargetDistance, m_fMaxTargetDistance, targetCount);
+		
+		if (bestPosition == vector.Zero)
+			return bestPosition;
+		
+		bestPosition[1] = m_Zone.GetSurfaceY(bestPosition[0], bestPosition[2]);
+		if (m_bDebugVisualization)
+			DebugDrawSamplePoint(bestPosition, targetCount, targetCount);
+		
+		return bestPosition;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Monte Carlo sampling to find best target position
+	//! Samples are drawn from the zone area in range of the mortar spawn point, see BakeSamplingDomains
+	//------------------------------------------------------------------------------------------------
+	protected vector FindBestTargetPositionMonteCarlo(MortarFireMissionData fireMission, AFM_DiDZoneCensus census, out int targetCount)
+	{
+		targetCount = -1;
 		
-		if (polylinePoints.Count() < 3)
+		AFM_DiDSamplingDomain domain = fireMission.m_SamplingDomain;
+		if (!domain || domain.IsEmpty())
 			return vector.Zero;
 		
-		// Calculate zone bounds
-		vector minBounds, maxBounds;
-		CalculateZoneBounds(polylinePoints, minBounds, maxBounds, polyline.GetOrigin());
+		vector bestPosition = SearchTargetPosition(domain, fireMission.m_SpawnPosition, census, m_eSampler, m_iMonteCarloSamples, m_fRefineFraction, targetCount);
+		if (bestPosition != vector.Zero)
+			bestPosition[1] = m_Zone.GetSurfaceY(bestPosition[0], bestPosition[2]);
+		
+		return bestPosition;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Two stage search, coarse samples over the domain then an even disk of samples around the
+	//! best coarse candidates. Returns vector.Zero when no sample is in range
+	//! @param refineFraction Share of samples spent on the second stage
+	//------------------------------------------------------------------------------------------------
+	protected vector SearchTargetPosition(AFM_DiDSamplingDomain domain, vector mortarPos, AFM_DiDZoneCensus census, EAFMMortarSampler sampler, int samples, float refineFraction, out int targetCount)
+	{
+		int refineSamples = Math.Floor(samples * Math.Clamp(refineFraction, 0, 1));
+		int coarseSamples = Math.Max(1, samples - refineSamples);
 		
-		// Monte Carlo sampling
-		vector bestPosition = vector.Zero;
+		array<vector> candidates = {};
+		array<int> candidateCounts = {};
 		
-		//TODO: remove me - this is to make mortar fire at anything
-		int maxTargetCount = -1;
-		WorldTimestamp tStart = GetCurrentTimestamp();
-		for (int i = 0; i < m_iMonteCarloSamples; i++)
+		array<vector> points = {};
+		AFM_DiDTargetSampler.Generate(sampler, domain, coarseSamples, s_AIRandomGenerator, points);
+		foreach (vector samplePos : points)
 		{
-			// Generate random point within zone bounds
-			vector samplePos = GenerateRandomPointInBounds(minBounds, maxBounds);
-			
-			// Debug visualization
-			if (m_bDebugVisualization)
-				DebugDrawSamplePoint(samplePos, 0, 0);
-			
-			// Check if point is actually inside the zone polygon
-			if (!IsPointInZone(samplePos, polylinePoints, polyline.GetOrigin()))
-				continue;
-			
-			// Check if within valid range from mortar
-			//float distToMortar = vector.Distance(mortarPos, samplePos);
-			float distToMortar = Math.Sqrt(Math.Pow(mortarPos[0] - samplePos[0],2) + Math.Pow(mortarPos[2] - samplePos[2], 2));
-			if (distToMortar < m_fMinTargetDistance || distToMortar > m_fMaxTargetDistance)
+			// Domain triangles crossing the range border are kept whole
+			if (!IsInTargetRange(mortarPos, samplePos))
 				continue;
 			
-			// Count targets around this sample point
-			int targetCount = CountDefendersInRadius(samplePos, m_fSampleRadius);
+			int sampleCount = CountDefendersInRadius(samplePos, m_fSampleRadius, census);
 			
-			// Debug visualization
 			if (m_bDebugVisualization)
-				DebugDrawSamplePoint(samplePos, targetCount, maxTargetCount);
-			
-			// Update best position if this sample has more targets
-			if (targetCount > maxTargetCount)
 			{
-				maxTargetCount = targetCount;
-				bestPosition = samplePos;
+				vector debugPos = samplePos;
+				debugPos[1] = m_Zone.GetSurfaceY(samplePos[0], samplePos[2]);
+				DebugDrawSamplePoint(debugPos, sampleCount, -1);
 			}
+			
+			InsertCandidate(candidates, candidateCounts, samplePos, sampleCount);
+		}
+		
+		if (candidates.IsEmpty())
+		{
+			targetCount = -1;
+			return vector.Zero;
 		}
 		
-		// Store for reference
-		if (m_mFireMissions.Count() > 0)
+		vector bestPosition = candidates[0];
+		targetCount = candidateCounts[0];
+		
+		// Nothing to improve on without any defender around
+		if (refineSamples == 0 || targetCount <= 0)
+			return bestPosition;
+		
+		int samplesPerCandidate = Math.Max(1, refineSamples / candidates.Count());
+		foreach (vector candidate : candidates)
 		{
-			// Find the fire mission we're updating (hacky, but works for now)
-			foreach (IEntity mortar, MortarFireMissionData fm : m_mFireMissions)
+			AFM_DiDTargetSampler.GenerateDisk(candidate, m_fSampleRadius, samplesPerCandidate, points);
+			foreach (vector refinePos : points)
 			{
-				if (fm.m_SpawnPosition == mortarPos)
-				{
-					fm.m_LastTargetCount = maxTargetCount;
-					break;
-				}
+				if (!IsInTargetRange(mortarPos, refinePos) || !m_Zone.IsPointInZone(refinePos))
+					continue;
+				
+				int refineCount = CountDefendersInRadius(refinePos, m_fSampleRadius, census);
+				if (refineCount <= targetCount)
+					continue;
+				
+				bestPosition = refinePos;
+				targetCount = refineCount;
 			}
 		}
-		WorldTimestamp end = GetCurrentTimestamp();
-		PrintFormat("AFM_DiDMortarSpawnerComponent: MC simulation took %1 ms", end.DiffMilliseconds(tStart));
+		
 		return bestPosition;
 	}
 	
 	//------------------------------------------------------------------------------------------------
-	//! Count defender units within radius of position
+	//! Keep the REFINE_CANDIDATES best samples ordered by count, first one is the best
 	//------------------------------------------------------------------------------------------------
-	protected int CountDefendersInRadius(vector centerPos, float radius)
+	protected void InsertCandidate(notnull array<vector> candidates, notnull array<int> counts, vector position, int count)
 	{
-		if (!m_Zone)
-			return 0;
+		int index = counts.Count();
+		while (index > 0 && counts[index - 1] < count)
+		{
+			index--;
+		}
 		
-		SCR_Faction defenderFaction = m_Zone.GetDefenderFaction();
-		if (!defenderFaction)
-			return 0;
+		if (index >= REFINE_CANDIDATES)
+			return;
 		
-		array<int> playerIds = {};
-		defenderFaction.GetPlayersInFaction(playerIds);
+		candidates.InsertAt(position, index);
+		counts.InsertAt(count, index);
 		
-		int count = 0;
-		float radiusSq = radius * radius;
+		if (counts.Count() > REFINE_CANDIDATES)
+		{
+			candidates.Remove(REFINE_CANDIDATES);
+			counts.Remove(REFINE_CANDIDATES);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected bool IsInTargetRange(vector mortarPos, vector targetPos)
+	{
+		float dx = mortarPos[0] - targetPos[0];
+		float dz = mortarPos[2] - targetPos[2];
+		float distSq = dx * dx + dz * dz;
+		return distSq >= m_fMinTargetDistance * m_fMinTargetDistance && distSq <= m_fMaxTargetDistance * m_fMaxTargetDistance;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Compare Monte Carlo samplers against a reference grid search on synthetic defender layouts
+	//! The reference only tests cell centers, so it is approximate and samplers can beat it.
+	//! Quality is the mean ratio of defenders found to the reference count and may exceed 1,
+	//! layouts are generated around the range domain of the first usable spawn point
+	//------------------------------------------------------------------------------------------------
+	void BenchmarkTargeting(int trials, notnull array<string> outLines)
+	{
+		int spawnPointIndex = -1;
+		foreach (int i, AFM_DiDSamplingDomain candidateDomain : m_aSamplingDomains)
+		{
+			if (!candidateDomain.IsEmpty())
+			{
+				spawnPointIndex = i;
+				break;
+			}
+		}
 		
-		foreach (int playerId : playerIds)
+		if (spawnPointIndex < 0)
 		{
-			PlayerController pc = GetGame().GetPlayerManager().GetPlayerController(playerId);
-			if (!pc)
-				continue;
-			
-			IEntity playerEntity = pc.GetControlledEntity();
-			if (!playerEntity)
-				continue;
-			
-			// Check if player is alive
-			SCR_ChimeraCharacter character = SCR_ChimeraCharacter.Cast(playerEntity);
-			if (!character)
-				continue;
+			outLines.Insert(string.Format("%1: no part of zone in mortar range", GetName()));
+			return;
+		}
+		
+		AFM_DiDSamplingDomain domain = m_aSamplingDomains[spawnPointIndex];
+		vector mortarPos = m_aSpawnPoints[spawnPointIndex].GetOrigin();
+		
+		// Reference search, a fine density grid counts exactly at every cell center
+		AFM_DiDDensityGrid reference = new AFM_DiDDensityGrid();
+		float cellSize = Math.Max(1, m_fSampleRadius * 0.2);
+		while (!reference.Init(m_Zone.GetGeometry(), cellSize, m_fSampleRadius))
+		{
+			cellSize *= 2;
+			if (cellSize > m_fSampleRadius)
+			{
+				outLines.Insert(string.Format("%1: zone too large for reference grid search", GetName()));
+				return;
+			}
+		}
+		
+		int reducedSamples = Math.Max(1, m_iMonteCarloSamples / 3);
+		array<EAFMMortarSampler> samplers = {EAFMMortarSampler.RANDOM, EAFMMortarSampler.RANDOM, EAFMMortarSampler.HALTON, EAFMMortarSampler.STRATIFIED, EAFMMortarSampler.HALTON, EAFMMortarSampler.STRATIFIED};
+		array<int> sampleCounts = {m_iMonteCarloSamples, reducedSamples, reducedSamples, reducedSamples, reducedSamples, reducedSamples};
+		array<float> refineFractions = {0, 0, 0, 0, m_fRefineFraction, m_fRefineFraction};
+		
+		array<float> quality = {};
+		array<int> referenceMatched = {};
+		quality.Resize(samplers.Count());
+		referenceMatched.Resize(samplers.Count());
+		
+		bool debugVisualization = m_bDebugVisualization;
+		m_bDebugVisualization = false;
+		
+		AFM_DiDZoneCensus census = new AFM_DiDZoneCensus();
+		int validTrials;
+		for (int trial = 0; trial < trials; trial++)
+		{
+			GenerateBenchmarkDefenders(domain, census.m_aDefenderPositions);
+			reference.Build(census.m_aDefenderPositions);
 			
-			SCR_DamageManagerComponent damageManager = character.GetDamageManager();
-			if (!damageManager || damageManager.GetState() == EDamageState.DESTROYED)
+			int referenceCount;
+			reference.FindBest(mortarPos, m_fMinTargetDistance, m_fMaxTargetDistance, referenceCount);
+			if (referenceCount <= 0)
 				continue;
 			
+			validTrials++;
+			foreach (int config, EAFMMortarSampler sampler : samplers)
+			{
+				int found;
+				SearchTargetPosition(domain, mortarPos, census, sampler, sampleCounts[config], refineFractions[config], found);
+				float ratio = found;
+				quality[config] = quality[config] + ratio / referenceCount;
+				if (found >= referenceCount)
+					referenceMatched[config] = referenceMatched[config] + 1;
+			}
+		}
+		
+		m_bDebugVisualization = debugVisualization;
+		
+		outLines.Insert(string.Format("%1: %2 trials, reference grid search (approximate) %3 m", GetName(), validTrials, cellSize));
+		if (validTrials == 0)
+			return;
+		
+		foreach (int config, EAFMMortarSampler sampler : samplers)
+		{
+			outLines.Insert(string.Format("  %1 n=%2 refine=%3: quality %4, matched or beat reference %5/%6",
+				typename.EnumToString(EAFMMortarSampler, sampler), sampleCounts[config], refineFractions[config],
+				quality[config] / validTrials, referenceMatched[config], validTrials));
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Few tight defender clusters plus scattered defenders
+	//! Cluster centers and scattered defenders are inside domain, cluster members may fall outside
+	//------------------------------------------------------------------------------------------------
+	protected void GenerateBenchmarkDefenders(AFM_DiDSamplingDomain domain, notnull array<vector> outPositions)
+	{
+		array<vector> centers = {};
+		AFM_DiDTargetSampler.Generate(EAFMMortarSampler.RANDOM, domain, BENCHMARK_CLUSTERS, s_AIRandomGenerator, centers);
+		AFM_DiDTargetSampler.Generate(EAFMMortarSampler.RANDOM, domain, BENCHMARK_SCATTERED, s_AIRandomGenerator, outPositions);
+		
+		foreach (vector center : centers)
+		{
+			int size = s_AIRandomGenerator.RandInt(2, 8);
+			for (int i = 0; i < size; i++)
+			{
+				float angle = s_AIRandomGenerator.RandFloatXY(0, Math.PI2);
+				float distance = m_fSampleRadius * 1.5 * Math.Sqrt(s_AIRandomGenerator.RandFloat01());
+				outPositions.Insert(center + Vector(distance * Math.Cos(angle), 0, distance * Math.Sin(angle)));
+			}
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Count defender units within radius of position, measured in 2D
+	//------------------------------------------------------------------------------------------------
+	protected int CountDefendersInRadius(vector centerPos, float radius, AFM_DiDZoneCensus census)
+	{
+		if (!census)
+			return 0;
+		
+		int count = 0;
+		float radiusSq = radius * radius;
+		
+		// Census only holds positions of alive defenders
+		foreach (vector playerPos : census.m_aDefenderPositions)
+		{
 			// Check distance (using squared distance for performance)
-			vector playerPos = playerEntity.GetOrigin();
-			float distSq = vector.DistanceSq(centerPos, playerPos);
+			float dx = centerPos[0] - playerPos[0];
+			float dz = centerPos[2] - playerPos[2];
+			float distSq = dx * dx + dz * dz;
 			
 			if (distSq <= radiusSq)
 				count++;
@@ -353,13 +652,56 @@ class AFM_DiDMortarSpawnerComponent: AFM_DiDSpawnerComponent
 		return count;
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Make fire waypoint the only waypoint of the crew
+	//! Crew keeps a running assignment unless replan is set, re-adding the waypoint makes it plan
+	//! the fire mission against the new position
+	//------------------------------------------------------------------------------------------------
+	protected void AssignFirePositionWaypoint(AIGroup crew, SCR_AIWaypointArtillerySupport fireWaypoint, bool replan)
+	{
+		array<AIWaypoint> existingWaypoints = {};
+		crew.GetWaypoints(existingWaypoints);
+		
+		bool assigned;
+		foreach (AIWaypoint wp : existingWaypoints)
+		{
+			if (wp == fireWaypoint)
+			{
+				assigned = true;
+				continue;
+			}
+			
+			// Waypoints not owned by the fire mission are only unassigned
+			crew.RemoveWaypoint(wp);
+		}
+		
+		if (assigned && replan)
+		{
+			crew.RemoveWaypoint(fireWaypoint);
+			assigned = false;
+		}
+		
+		// Completed fire missions drop the waypoint from the crew, it is re-added to fire again
+		if (!assigned)
+			crew.AddWaypoint(fireWaypoint);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Move existing fire position waypoint to target location
+	//------------------------------------------------------------------------------------------------
+	protected void PlaceFirePositionWaypoint(SCR_AIWaypointArtillerySupport fireWaypoint, vector targetPos)
+	{
+		targetPos[1] = GetGame().GetWorld().GetSurfaceY(targetPos[0], targetPos[2]);
+		fireWaypoint.SetOrigin(targetPos);
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	//! Create fire position waypoint at target location
 	//------------------------------------------------------------------------------------------------
-	protected SCR_AIWaypointArtillerySupport CreateFirePositionWaypoint(vector targetPos, MortarFireMissionData fireMission)
+	protected SCR_AIWaypointArtillerySupport CreateFirePositionWaypoint(vector targetPos)
 	{
-		Resource wpResource = Resource.Load("{C524700A27CFECDD}Prefabs/AI/Waypoints/AIWaypoint_ArtillerySupport.et");
-		if (!wpResource || !wpResource.IsValid())
+		Resource wpResource = AFM_DiDPrefabCache.Load(FIRE_WAYPOINT_PREFAB);
+		if (!wpResource)
 			return null;
 		
 		EntitySpawnParams spawnParams = new EntitySpawnParams();
@@ -378,45 +720,6 @@ class AFM_DiDMortarSpawnerComponent: AFM_DiDSpawnerComponent
 	// Helper methods
 	//------------------------------------------------------------------------------------------------
 	
-	protected void CalculateZoneBounds(array<vector> points, out vector minBounds, out vector maxBounds, vector polylineOrigin)
-	{
-		minBounds = polylineOrigin + points[0];
-		maxBounds = polylineOrigin + points[0];
-		
-		foreach (vector point : points)
-		{
-			minBounds[0] = Math.Min(minBounds[0], polylineOrigin[0] + point[0]);
-			minBounds[2] = Math.Min(minBounds[2], polylineOrigin[2] + point[2]);
-			maxBounds[0] = Math.Max(maxBounds[0], polylineOrigin[0] + point[0]);
-			maxBounds[2] = Math.Max(maxBounds[2], polylineOrigin[2] + point[2]);
-		}
-	}
-	
-	protected vector GenerateRandomPointInBounds(vector minBounds, vector maxBounds)
-	{
-		vector point;
-		point[0] = s_AIRandomGenerator.RandFloatXY(minBounds[0], maxBounds[0]);
-		point[2] = s_AIRandomGenerator.RandFloatXY(minBounds[2], maxBounds[2]);
-		point[1] = GetGame().GetWorld().GetSurfaceY(point[0], point[2]);
-		return point;
-	}
-	
-	protected bool IsPointInZone(vector point, array<vector> polylinePoints, vector polylineOrigin)
-	{
-		//init polyline point array once
-		if (!m_aPolylinePoints2D)
-		{
-			m_aPolylinePoints2D = new array<float>();
-			foreach (vector p : polylinePoints)
-			{
-				m_aPolylinePoints2D.Insert(polylineOrigin[0] + p[0]);
-				m_aPolylinePoints2D.Insert(polylineOrigin[2] + p[2]);
-			}
-		}
-		
-		return Math2D.IsPointInPolygon(m_aPolylinePoints2D, point[0], point[2]);
-	}
-	
 	protected void DebugDrawSamplePoint(vector pos, int targetCount, int maxCount)
 	{
 		Color color = Color.Yellow;
@@ -439,7 +742,8 @@ class MortarFireMissionData
 {
 	IEntity m_Mortar;
 	AIGroup m_CrewGroup;
-	SCR_AIWaypoint m_CurrentWaypoint;
+	SCR_AIWaypointArtillerySupport m_CurrentWaypoint;
+	AFM_DiDSamplingDomain m_SamplingDomain;
 	vector m_SpawnPosition;
 	vector m_TargetPosition;
 	WorldTimestamp m_LastUpdateTime;
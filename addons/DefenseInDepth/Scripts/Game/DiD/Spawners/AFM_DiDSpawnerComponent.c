@@ -18,17 +18,33 @@ class AFM_DiDSpawnerComponent: GenericEntity
 	[Attribute("5", UIWidgets.EditBox, "Base AI spawn count per wave", category: "DiD Spawner")]
 	protected int m_iSpawnCountPerWave;
 	
-	[Attribute("50", UIWidgets.EditBox, "Max AI group count", category: "DiD Spawner")]
+	[Attribute("50", UIWidgets.EditBox, "Max number of AI agents alive from this spawner", category: "DiD Spawner")]
 	protected int m_iMaxAICount;
 	
 	[Attribute("1.0", UIWidgets.EditBox, "Spawn count multiplier per zone level (e.g., zone 2 = 2x spawn count)", category: "DiD Spawner")]
 	protected float m_fZoneLevelMultiplier;
 	
+	[Attribute("0", UIWidgets.EditBox, "Spawn queue priority, requests with higher priority are spawned first", category: "DiD Spawner")]
+	protected int m_iSpawnPriority;
+	
+	[Attribute("1", UIWidgets.EditBox, "Share of the zone AI budget relative to the other spawners of the zone", category: "DiD Spawner")]
+	protected float m_fAIBudgetWeight;
+	
 	protected AFM_DiDZoneComponent m_Zone;
 	protected ref array<AFM_SpawnPointEntity> m_aSpawnPoints = {};
 	protected ref array<SCR_AIWaypoint> m_aAIWaypoints = {};
 	protected ref array<AIGroup> m_aSpawnedAIGroups = {};
-	protected WorldTimestamp m_fLastSpawnTime;
+	protected WorldTimestamp m_fNextWaveTime;
+	protected int m_iPendingSpawns;
+	
+	// Agents in m_aSpawnedAIGroups, maintained from group agent events
+	protected int m_iActiveAICount;
+	
+	// Built once in Prepare, the zone times Process under this name every frame
+	protected string m_sProfilerScope;
+	
+	// Groups staged by StageFirstWave, the first wave spawns exactly this many (0 = not staged)
+	protected int m_iStagedWaveCount;
 	
 	//------------------------------------------------------------------------------------------------
 	// Prepare method - called by owner zone component on start
@@ -36,6 +52,7 @@ class AFM_DiDSpawnerComponent: GenericEntity
 	void Prepare(AFM_DiDZoneComponent owner)
 	{
 		m_Zone = owner;
+		m_sProfilerScope = "spawner.process." + ClassName();
 		// Find spawn points and waypoints in children
 		IEntity child = GetChildren();
 		while (child)
@@ -60,37 +77,73 @@ class AFM_DiDSpawnerComponent: GenericEntity
 		}
 		
 		if (m_aSpawnPoints.Count() == 0)
-			PrintFormat("AFM_DiDSpawnerComponent: No spawn points found in spawner!", LogLevel.WARNING);
+			PrintFormat("AFM_DiDSpawnerComponent: No spawn points found in spawner!", level: LogLevel.WARNING);
 		
 		if (m_aAIWaypoints.Count() == 0)
-			PrintFormat("AFM_DiDSpawnerComponent: No waypoints found in spawner!", LogLevel.WARNING);
-		
-		ChimeraWorld world = GetGame().GetWorld();
-		m_fLastSpawnTime = world.GetServerTimestamp().PlusSeconds(-m_iWaveIntervalSeconds);
+			PrintFormat("AFM_DiDSpawnerComponent: No waypoints found in spawner!", level: LogLevel.WARNING);
 	}
 	
 	//------------------------------------------------------------------------------------------------
 	// Main process method - called periodically by the owner zone component
+	// census is the snapshot the zone took at its last check
+	// Waves are driven by the zone system wave scheduler, see StartWaves
 	//------------------------------------------------------------------------------------------------
-	void Process()
+	void Process(AFM_DiDZoneCensus census)
+	{
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Start wave timer, first wave is spawned right away
+	//! Called by owner zone component when the zone becomes active
+	//------------------------------------------------------------------------------------------------
+	void StartWaves()
+	{
+		m_fNextWaveTime = GetCurrentTimestamp();
+		AFM_DiDZoneSystem.GetInstance().GetWaveScheduler().Schedule(this, m_fNextWaveTime);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Called by the wave scheduler when the next wave is due
+	//------------------------------------------------------------------------------------------------
+	void OnWaveTimer()
 	{
 		if (!m_Zone)
 			return;
 		
-		// Only spawn during active or frozen states
+		// Only spawn during active or frozen states, timer stops with the zone
 		EAFMZoneState state = m_Zone.GetZoneState();
 		if (state != EAFMZoneState.ACTIVE && state != EAFMZoneState.FROZEN)
 			return;
 		
-		ChimeraWorld world = GetGame().GetWorld();
-		WorldTimestamp now = world.GetServerTimestamp();
+		AFM_DiDProfiler profiler = AFM_DiDZoneSystem.GetInstance().GetProfiler();
+		int profileStart = profiler.Begin();
+		SpawnWave();
+		profiler.End("spawner.wave", profileStart);
 		
-		int timeSinceLastSpawn = Math.AbsInt(now.DiffSeconds(m_fLastSpawnTime));
-		if (timeSinceLastSpawn >= m_iWaveIntervalSeconds)
-		{
-			m_fLastSpawnTime = now;
-			SpawnWave();
-		}
+		// Schedule from the planned time so waves don't drift with frame time
+		m_fNextWaveTime = m_fNextWaveTime.PlusSeconds(GetNextWaveInterval());
+		WorldTimestamp now = GetCurrentTimestamp();
+		if (m_fNextWaveTime.Less(now))
+			m_fNextWaveTime = now;
+		
+		AFM_DiDZoneSystem.GetInstance().GetWaveScheduler().Schedule(this, m_fNextWaveTime);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Seconds until the next wave, drawn once per wave
+	//! Override this for custom wave timing
+	//------------------------------------------------------------------------------------------------
+	protected float GetNextWaveInterval()
+	{
+		return m_iWaveIntervalSeconds;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void StopWaves()
+	{
+		AFM_DiDZoneSystem zoneSystem = AFM_DiDZoneSystem.GetInstance();
+		if (zoneSystem)
+			zoneSystem.GetWaveScheduler().Cancel(this);
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -98,6 +151,9 @@ class AFM_DiDSpawnerComponent: GenericEntity
 	//------------------------------------------------------------------------------------------------
 	void Cleanup()
 	{
+		m_iStagedWaveCount = 0;
+		StopWaves();
+		CancelQueuedSpawns();
 		RemoveSpawnedAI();
 	}
 	
@@ -119,19 +175,82 @@ class AFM_DiDSpawnerComponent: GenericEntity
 	}
 	
 	//------------------------------------------------------------------------------------------------
-	//! Get the current count of active AI groups
+	//! Get the current count of active AI agents
 	//------------------------------------------------------------------------------------------------
 	int GetActiveAICount()
 	{
-		int count = 0;
-		for (int i = m_aSpawnedAIGroups.Count() - 1; i >= 0; i--)
-		{
-			AIGroup group = m_aSpawnedAIGroups[i];
-			if (!group)
-				continue;
-			count += group.GetAgentsCount();
-		}
-		return count;
+		return m_iActiveAICount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Start tracking spawned group, its agents are counted from now on
+	//------------------------------------------------------------------------------------------------
+	protected void AddSpawnedGroup(AIGroup group)
+	{
+		SCR_AIGroup scrGroup = SCR_AIGroup.Cast(group);
+		if (scrGroup)
+			scrGroup.SetDiDSpawner(this);
+		
+		m_aSpawnedAIGroups.Insert(group);
+		ChangeActiveAICount(group.GetAgentsCount());
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Called by tracked groups when an agent joins
+	//------------------------------------------------------------------------------------------------
+	void OnGroupAgentAdded(AIGroup group, AIAgent agent)
+	{
+		ChangeActiveAICount(1);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Called by tracked groups when an agent leaves (death, deletion), empty groups are dropped
+	//------------------------------------------------------------------------------------------------
+	void OnGroupAgentRemoved(AIGroup group, AIAgent agent)
+	{
+		ChangeActiveAICount(-1);
+		
+		if (group.GetAgentsCount() > 0)
+			return;
+		
+		int index = m_aSpawnedAIGroups.Find(group);
+		if (index < 0)
+			return;
+		
+		m_aSpawnedAIGroups.Remove(index);
+		DetachGroup(group);
+		
+		// Empty group has nothing visible, delete it once the current event is done instead of
+		// queueing it behind the zone despawns
+		GetGame().GetCallqueue().Call(DeleteEmptyGroup, group);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void DeleteEmptyGroup(AIGroup group)
+	{
+		if (group && group.GetAgentsCount() == 0)
+			SCR_EntityHelper.DeleteEntityAndChildren(group);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void DetachGroup(AIGroup group)
+	{
+		SCR_AIGroup scrGroup = SCR_AIGroup.Cast(group);
+		if (scrGroup)
+			scrGroup.SetDiDSpawner(null);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void ChangeActiveAICount(int delta)
+	{
+		int count = Math.Max(0, m_iActiveAICount + delta);
+		delta = count - m_iActiveAICount;
+		if (delta == 0)
+			return;
+		
+		m_iActiveAICount = count;
+		if (m_Zone)
+			m_Zone.OnActiveAICountChanged(delta);
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -145,28 +264,123 @@ class AFM_DiDSpawnerComponent: GenericEntity
 		
 		if (m_aAIGroupPrefabs.Count() == 0)
 		{
-			PrintFormat("AFM_DiDSpawnerComponent: No AI group prefabs configured!", LogLevel.WARNING);
+			PrintFormat("AFM_DiDSpawnerComponent: No AI group prefabs configured!", level: LogLevel.WARNING);
 			return;
 		}
 		
-		if (m_Zone.GetActiveAICount() >= m_iMaxAICount)
+		if (!HasAIBudget())
 		{
-			PrintFormat("AFM_DiDSpawnerComponent: Max AI count reached (%1/%2)", GetActiveAICount(), m_iMaxAICount, LogLevel.DEBUG);
+			if (AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG))
+				AFM_DiDLog.Write(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG, string.Format("AFM_DiDSpawnerComponent: Max AI count reached (%1/%2)", GetActiveAICount(), GetAIBudget()));
 			return;
 		}
 		
-		int spawnCount = GetSpawnCountForWave();
-		PrintFormat("AFM_DiDSpawnerComponent: Spawning wave with %1 groups", spawnCount, LogLevel.DEBUG);
+		// First wave picks up the staged groups, rolling again could leave some of them unused
+		int spawnCount = m_iStagedWaveCount;
+		m_iStagedWaveCount = 0;
+		
+		// Waves shrink with the budget the governor grants
+		if (spawnCount <= 0)
+			spawnCount = Math.Max(1, Math.Round(GetSpawnCountForWave() * AFM_DiDZoneSystem.GetInstance().GetAIBudgetScale()));
+		
+		if (AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG))
+			AFM_DiDLog.Write(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG, string.Format("AFM_DiDSpawnerComponent: Spawning wave with %1 groups", spawnCount));
 		
-		for (int i = 0; i < spawnCount; i++)
+		QueueSpawns(spawnCount);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Push group spawns to the zone system spawn queue, AI limit is checked again when spawned
+	//------------------------------------------------------------------------------------------------
+	protected void QueueSpawns(int count)
+	{
+		AFM_DiDSpawnQueue queue = AFM_DiDZoneSystem.GetInstance().GetSpawnQueue();
+		for (int i = 0; i < count; i++)
 		{
-			if (m_Zone.GetActiveAICount() >= m_iMaxAICount)
-				break;
-			
-			SpawnSingleGroup();
+			queue.Enqueue(this, m_iSpawnPriority);
+			m_iPendingSpawns++;
 		}
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	protected void CancelQueuedSpawns()
+	{
+		AFM_DiDZoneSystem zoneSystem = AFM_DiDZoneSystem.GetInstance();
+		if (zoneSystem)
+			zoneSystem.GetSpawnQueue().CancelSpawner(this);
+		
+		m_iPendingSpawns = 0;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Called by the spawn queue when request of this spawner is due
+	//------------------------------------------------------------------------------------------------
+	void ExecuteSpawnRequest(AFM_DiDSpawnRequest request)
+	{
+		m_iPendingSpawns = Math.Max(0, m_iPendingSpawns - 1);
+		
+		if (!CanExecuteSpawn())
+			return;
+		
+		AFM_DiDProfiler profiler = AFM_DiDZoneSystem.GetInstance().GetProfiler();
+		int profileStart = profiler.Begin();
+		SpawnSingleGroup();
+		profiler.End("spawner.spawnGroup", profileStart);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Check done right before a queued spawn is executed
+	//! Override this for custom spawn limits
+	//------------------------------------------------------------------------------------------------
+	protected bool CanExecuteSpawn()
+	{
+		if (!m_Zone)
+			return false;
+		
+		EAFMZoneState state = m_Zone.GetZoneState();
+		if (state != EAFMZoneState.ACTIVE && state != EAFMZoneState.FROZEN)
+			return false;
+		
+		return HasAIBudget();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Spawner limit, zone limit and the share of the dynamic zone budget all have room left
+	//------------------------------------------------------------------------------------------------
+	protected bool HasAIBudget()
+	{
+		int zoneCount = m_Zone.GetActiveAICount();
+		if (zoneCount >= m_iMaxAICount || zoneCount >= m_Zone.GetAIBudget())
+			return false;
+		
+		return GetActiveAICount() < GetAIBudget();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Max AI agents of this spawner, its weighted share of the zone budget
+	//------------------------------------------------------------------------------------------------
+	int GetAIBudget()
+	{
+		if (!m_Zone)
+			return m_iMaxAICount;
+		
+		return Math.Min(m_iMaxAICount, m_Zone.GetSpawnerAIBudget(this));
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Override this for spawners that do not take part in the AI budget
+	//------------------------------------------------------------------------------------------------
+	float GetAIBudgetWeight()
+	{
+		return m_fAIBudgetWeight;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	string GetProfilerScope()
+	{
+		return m_sProfilerScope;
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	//! Spawn a single AI group
 	//! Override this for custom group spawning logic
@@ -180,25 +394,47 @@ class AFM_DiDSpawnerComponent: GenericEntity
 		AIGroup group = SpawnAI(groupPrefab, spawnPoint, waypoint);
 		if (group)
 		{
-			m_aSpawnedAIGroups.Insert(group);
-			PrintFormat("AFM_DiDSpawnerComponent: Spawned AI group %1 at %2", groupPrefab, spawnPoint.GetOrigin().ToString(), LogLevel.DEBUG);
+			AddSpawnedGroup(group);
+			if (AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG))
+				AFM_DiDLog.Write(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG, string.Format("AFM_DiDSpawnerComponent: Spawned AI group %1 at %2", groupPrefab, spawnPoint.GetOrigin()));
 		}
 		else
 		{
-			PrintFormat("AFM_DiDSpawnerComponent: Failed to spawn AI group %1", groupPrefab, LogLevel.ERROR);
+			AFM_DiDLog.Write(EAFMDiDLogCategory.SPAWNER, LogLevel.ERROR, string.Format("AFM_DiDSpawnerComponent: Failed to spawn AI group %1", groupPrefab));
 		}
 	}
 	
 	//------------------------------------------------------------------------------------------------
-	//! Remove all spawned AI groups
+	//! Can groups of this spawner be parked in and taken from the group pool
+	//! Only plain infantry groups are interchangeable, override to opt in
+	//------------------------------------------------------------------------------------------------
+	protected bool CanPoolGroups()
+	{
+		return false;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Remove all spawned AI groups, parks them in the group pool when enabled
 	//------------------------------------------------------------------------------------------------
 	protected void RemoveSpawnedAI()
 	{
+		AFM_DiDGroupPool pool;
+		AFM_DiDZoneSystem zoneSystem = AFM_DiDZoneSystem.GetInstance();
+		if (zoneSystem && CanPoolGroups())
+			pool = zoneSystem.GetGroupPool();
+		
 		foreach (AIGroup group : m_aSpawnedAIGroups)
 		{
 			if (!group)
 				continue;
 			
+			// Removed agents must not touch the counter anymore
+			DetachGroup(group);
+			
+			// Survivors are parked for later waves when pooling is enabled
+			if (pool && pool.Park(group))
+				continue;
+			
 			array<AIAgent> agents = {};
 			group.GetAgents(agents);
 			
@@ -206,13 +442,113 @@ class AFM_DiDSpawnerComponent: GenericEntity
 			{
 				if (!agent)
 					continue;
-				IEntity ent = agent.GetControlledEntity();
-				if (!ent)
-					continue;
-				SCR_EntityHelper.DeleteEntityAndChildren(ent);
+				Despawn(agent.GetControlledEntity());
 			}
 		}
 		m_aSpawnedAIGroups.Clear();
+		ChangeActiveAICount(-m_iActiveAICount);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Hand entity over to the zone system despawn queue, deleted over the next frames
+	//------------------------------------------------------------------------------------------------
+	protected void Despawn(IEntity entity)
+	{
+		if (!entity)
+			return;
+		
+		AFM_DiDZoneSystem zoneSystem = AFM_DiDZoneSystem.GetInstance();
+		if (zoneSystem)
+			zoneSystem.GetDespawnQueue().Enqueue(entity);
+		else
+			SCR_EntityHelper.DeleteEntityAndChildren(entity);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Append all prefabs this spawner may spawn, used for preloading
+	//! Override this when spawning additional prefabs
+	//------------------------------------------------------------------------------------------------
+	void CollectPrefabs(notnull array<ResourceName> outPrefabs)
+	{
+		if (m_aAIGroupPrefabs)
+			outPrefabs.InsertAll(m_aAIGroupPrefabs);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Spawn first wave of the zone ahead of time and park it in the group pool, disabled and out
+	//! of sight, SpawnAI picks the staged groups up once the zone becomes active
+	//! Override this when the spawner cannot use pooled groups
+	//------------------------------------------------------------------------------------------------
+	void StageFirstWave(notnull AFM_DiDGroupPool pool)
+	{
+		if (!CanPoolGroups() || m_aSpawnPoints.Count() == 0 || m_aAIGroupPrefabs.Count() == 0)
+			return;
+		
+		vector transform[4];
+		Math3D.MatrixIdentity4(transform);
+		transform[3] = pool.GetHoldingPosition();
+		
+		// Same wave size SpawnWave would use under the current governor budget, stored so the
+		// first wave spawns this many instead of rolling again
+		int count = Math.Max(1, Math.Round(GetSpawnCountForWave() * AFM_DiDZoneSystem.GetInstance().GetAIBudgetScale()));
+		int agentBudget = GetAIBudget();
+		int stagedAgents = 0;
+		m_iStagedWaveCount = 0;
+		for (int i = 0; i < count; i++)
+		{
+			if (stagedAgents >= agentBudget)
+				break;
+			
+			SCR_AIGroup group = SCR_AIGroup.Cast(SpawnPrefabAt(m_aAIGroupPrefabs.GetRandomElement(), transform));
+			if (!group)
+				continue;
+			
+			m_iStagedWaveCount++;
+			stagedAgents += group.GetNumberOfMembersToSpawn();
+			
+			// Members are switched off as they spawn so none of them simulates at the holding position
+			group.SetDiDStagingPool(pool);
+			array<AIAgent> agents = {};
+			group.GetAgents(agents);
+			foreach (AIAgent agent : agents)
+			{
+				pool.HoldMember(agent);
+			}
+			
+			// Group members are spawned over the next frames
+			GetGame().GetCallqueue().CallLater(ParkStagedGroup, 1000, false, group);
+		}
+		
+		if (AFM_DiDLog.IsEnabled(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG))
+			AFM_DiDLog.Write(EAFMDiDLogCategory.SPAWNER, LogLevel.DEBUG, string.Format("AFM_DiDSpawnerComponent: Staged %1 groups with %2 agents for zone %3", m_iStagedWaveCount, stagedAgents, m_Zone.GetZoneIndex()));
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void ParkStagedGroup(SCR_AIGroup group)
+	{
+		if (!group)
+			return;
+		
+		group.SetDiDStagingPool(null);
+		
+		AFM_DiDZoneSystem zoneSystem = AFM_DiDZoneSystem.GetInstance();
+		AFM_DiDGroupPool pool;
+		if (zoneSystem)
+			pool = zoneSystem.GetGroupPool();
+		
+		// Reserved for the zone it was staged for
+		DisableAIUnconsciousness(group);
+		if (pool && pool.Park(group, m_Zone.GetZoneIndex()))
+			return;
+		
+		array<AIAgent> agents = {};
+		group.GetAgents(agents);
+		foreach (AIAgent agent : agents)
+		{
+			if (agent)
+				Despawn(agent.GetControlledEntity());
+		}
+		Despawn(group);
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -223,15 +559,30 @@ class AFM_DiDSpawnerComponent: GenericEntity
 		return m_aAIGroupPrefabs;
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Spawn group prefab, reuses a parked group of the same prefab when available
+	//------------------------------------------------------------------------------------------------
 	protected AIGroup SpawnAI(ResourceName groupPrefab, IEntity spawnPoint, SCR_AIWaypoint waypoint)
 	{	
-		IEntity entity = SpawnPrefab(groupPrefab, spawnPoint);
-		AIGroup aigroup = AIGroup.Cast(entity);
+		AFM_DiDZoneSystem zoneSystem = AFM_DiDZoneSystem.GetInstance();
+		AFM_DiDGroupPool pool = zoneSystem.GetGroupPool();
+		
+		AIGroup aigroup;
+		if (pool && CanPoolGroups())
+			aigroup = pool.Acquire(groupPrefab, spawnPoint, m_Zone.GetZoneIndex());
+		
+		// Pooled members already had unconsciousness disabled
+		bool reused = aigroup != null;
+		if (!reused)
+			aigroup = AIGroup.Cast(SpawnPrefab(groupPrefab, spawnPoint));
+		
 		if (!aigroup)
 			return null;
 		
 		aigroup.AddWaypoint(waypoint);
-		GetGame().GetCallqueue().CallLater(DisableAIUnconsciousness, 500, false, aigroup);
+		zoneSystem.GetAttackerRegistry().TrackGroup(aigroup);
+		if (!reused)
+			GetGame().GetCallqueue().CallLater(DisableAIUnconsciousness, 500, false, aigroup);
 		return aigroup;
 	}
 	
@@ -256,12 +607,22 @@ class AFM_DiDSpawnerComponent: GenericEntity
 	//------------------------------------------------------------------------------------------------
 	protected IEntity SpawnPrefab(ResourceName prefab, IEntity spawnPoint)
 	{
-		EntitySpawnParams spawnParams = new EntitySpawnParams();
 		vector mat[4];
 		spawnPoint.GetWorldTransform(mat);
-		spawnParams.Transform = mat;
+		return SpawnPrefabAt(prefab, mat);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected IEntity SpawnPrefabAt(ResourceName prefab, vector transform[4])
+	{
+		EntitySpawnParams spawnParams = new EntitySpawnParams();
+		spawnParams.Transform = transform;
+		
+		Resource resource = AFM_DiDPrefabCache.Load(prefab);
+		if (!resource)
+			return null;
 		
-		return GetGame().SpawnEntityPrefab(Resource.Load(prefab), GetGame().GetWorld(), spawnParams);
+		return GetGame().SpawnEntityPrefab(resource, GetGame().GetWorld(), spawnParams);
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -1,9 +1,57 @@
 modded class SCR_AIGroup : ChimeraAIGroup
 {
+	protected AFM_DiDAttackerRegistry m_AttackerRegistry;
+	protected AFM_DiDSpawnerComponent m_DiDSpawner;
+	protected AFM_DiDGroupPool m_DiDStagingPool;
+	
 	override void EOnInit(IEntity owner)
 	{
 		if (SCR_Global.IsEditMode())
 			return;
 		super.EOnInit(owner);
 	}
+	
+	override void OnAgentAdded(AIAgent child)
+	{
+		super.OnAgentAdded(child);
+		
+		if (m_AttackerRegistry)
+			m_AttackerRegistry.Register(child);
+		
+		if (m_DiDSpawner)
+			m_DiDSpawner.OnGroupAgentAdded(this, child);
+		
+		if (m_DiDStagingPool)
+			m_DiDStagingPool.HoldMember(child);
+	}
+	
+	override void OnAgentRemoved(AIAgent child)
+	{
+		super.OnAgentRemoved(child);
+		
+		if (m_AttackerRegistry)
+		{
+			m_AttackerRegistry.Unregister(child);
+			AFM_DiDZoneSystem.GetInstance().OnAttackerRemoved(child);
+		}
+		
+		if (m_DiDSpawner)
+			m_DiDSpawner.OnGroupAgentRemoved(this, child);
+	}
+	
+	void SetAttackerRegistry(AFM_DiDAttackerRegistry registry)
+	{
+		m_AttackerRegistry = registry;
+	}
+	
+	void SetDiDSpawner(AFM_DiDSpawnerComponent spawner)
+	{
+		m_DiDSpawner = spawner;
+	}
+	
+	//! Members added while set are switched off right away, used for groups staged ahead of a zone
+	void SetDiDStagingPool(AFM_DiDGroupPool pool)
+	{
+		m_DiDStagingPool = pool;
+	}
 }
\ No newline at end of file